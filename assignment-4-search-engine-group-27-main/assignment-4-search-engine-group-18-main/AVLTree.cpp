@@ -1,36 +1,29 @@
 // avltree.cpp
 #include "AVLTree.h"
+#include "index_file.h"
 #include <algorithm>
 #include <iostream>
 #include <fstream>
-#include <sstream>
 
 AVLTree::~AVLTree() {
-    // Make sure to call clear in the destructor to free allocated memory
-    clear(root);
+    // The arenas release their slabs; nodes own no other memory
 }
 
 void AVLTree::clear() {
-    // Call the recursive clear function starting from the root
-    clear(root);
-    // Set the root to nullptr after clearing
+    // Nothing has to be visited, every node, key and posting buffer is arena memory
     root = nullptr;
+    nodeArena.reset();
+    dataArena.reset();
 }
 
-void AVLTree::clear(AVLNode* node) {
-    if (node != nullptr) {
-        // Recursively clear the left and right subtrees
-        clear(node->left);
-        clear(node->right);
+AVLNode::AVLNode(Arena& data, std::string_view word)
+    : key(data.copyString(word)), postings(ArenaAllocator<Posting>(&data)),
+      height(1), frequency(0), left(nullptr), right(nullptr) {}
 
-        // Delete the current node
-        delete node;
-    }
-}
-
-AVLNode::AVLNode(const std::string& word, const std::string& document)
-    : key(word),frequency(1), height(1), left(nullptr), right(nullptr) {
-    documents.push_back(document);
+AVLNode::AVLNode(Arena& data, std::string_view word, uint32_t document, int count)
+    : key(data.copyString(word)), postings(ArenaAllocator<Posting>(&data)),
+      height(1), frequency(count), left(nullptr), right(nullptr) {
+    postings.push_back({document, static_cast<uint32_t>(count)});
 }
 
 AVLTree::AVLTree() : root(nullptr) {}
@@ -97,42 +90,55 @@ AVLNode* AVLTree::balanceNode(AVLNode* node) {
     return node;
 }
 
-AVLNode* AVLTree::insertNode(AVLNode* node, const std::string& word, const std::string& document) {
+AVLNode* AVLTree::insertNode(AVLNode* node, std::string_view word, uint32_t document, int count) {
     if (node == nullptr)
-        return new AVLNode(word, document);
+        return nodeArena.create<AVLNode>(dataArena, word, document, count);
 
     if (word < node->key)
-        node->left = insertNode(node->left, word, document);
+        node->left = insertNode(node->left, word, document, count);
     else if (word > node->key)
-        node->right = insertNode(node->right, word, document);
+        node->right = insertNode(node->right, word, document, count);
     else {
-        node->frequency++;
-        auto it = std::find(node->documents.begin(), node->documents.end(), document);
-        if (it == node->documents.end()) {
-            node->documents.push_back(document);
+        node->frequency += count;
+        // Documents are indexed in ID order, so a repeat can only be the last posting
+        if (!node->postings.empty() && node->postings.back().docId == document) {
+            node->postings.back().frequency += count;
+        } else {
+            node->postings.push_back({document, static_cast<uint32_t>(count)});
         }
-        // node->documents.push_back(document); // Word already exists, add the document
+        return node; // shape did not change, nothing to rebalance
     }
 
     return balanceNode(node);
 }
 
-void AVLTree::insert(const std::string& word, const std::string& document) {
-    root = insertNode(root, word, document);
+void AVLTree::insert(std::string_view word, uint32_t document, int count) {
+    root = insertNode(root, word, document, count);
+}
+
+void AVLTree::insertDocument(uint32_t document, std::vector<std::string_view> terms) {
+    // Pre-aggregate: sort the terms so equal ones are adjacent, then insert each run once
+    std::sort(terms.begin(), terms.end());
+
+    for (size_t i = 0; i < terms.size();) {
+        size_t j = i + 1;
+        while (j < terms.size() && terms[j] == terms[i]) {
+            ++j;
+        }
+        root = insertNode(root, terms[i], document, static_cast<int>(j - i));
+        i = j;
+    }
 }
 
 void inOrderTraversalPrint(AVLNode* node) {
     if (node != nullptr) {
         inOrderTraversalPrint(node->left);
-        std::cout << node->key <<", Freq ="<< node->frequency << "";
-        if (!node->documents.empty()) {
-            auto it = node->documents.begin();
-            std::cout << *it;
-            ++it;
-
-            for (; it != node->documents.end(); ++it) {
-                std::cout << ", " << *it;
+        std::cout << node->key <<", Freq ="<< node->frequency << " ";
+        for (auto it = node->postings.begin(); it != node->postings.end(); ++it) {
+            if (it != node->postings.begin()) {
+                std::cout << ", ";
             }
+            std::cout << it->docId << ":" << it->frequency;
         }
         std::cout << std::endl;
         inOrderTraversalPrint(node->right);
@@ -143,111 +149,111 @@ void AVLTree::printInOrder() {
     inOrderTraversalPrint(root);
 }
 
-void AVLTree::inOrderTraversal(AVLNode* node, std::ofstream& outFile) {
+void AVLTree::inOrderTraversal(AVLNode* node, IndexFileWriter& writer) {
     if (node != nullptr) {
-        inOrderTraversal(node->left, outFile);
-
-        // Write node data to the file
-        outFile << node->key << "," << node->frequency << ",";
-        for (auto it = node->documents.begin(); it != node->documents.end(); ++it) {
-            outFile << *it;
-            if (std::next(it) != node->documents.end()) {
-                outFile << ",";
-            }
-        }
-        outFile << std::endl;
-        inOrderTraversal(node->right, outFile);
+        inOrderTraversal(node->left, writer);
+
+        // Write node data to the file, in-order keeps the terms sorted
+        writer.addTerm(node->key, static_cast<uint32_t>(node->frequency),
+                       node->postings.data(), node->postings.size());
+
+        inOrderTraversal(node->right, writer);
     }
 }
 
 
-void AVLTree::saveToFile(const std::string& fileName) {
-    std::ofstream outFile(fileName, std::ios_base::app);
-
-    if (!outFile.is_open()) {
-        std::cerr << "Error opening file for writing: " << fileName << std::endl;
-        return;
+bool AVLTree::saveToFile(const std::string& fileName) {
+    IndexFileWriter writer;
+    if (!writer.open(fileName)) {
+        return false;
     }
 
-    inOrderTraversal(root, outFile);
+    inOrderTraversal(root, writer);
 
-    outFile.close();
+    return writer.close();
 }
 
-std::vector<std::string> tokenize(const std::string& input) {
-    std::istringstream iss(input);
-    std::vector<std::string> tokens;
-    std::string token;
-    while (iss >> token) {
-        iss.ignore();
-        tokens.push_back(token);
-    }
-    return tokens;
+AVLNode* AVLTree::buildBalanced(const IndexFileReader& reader, size_t first, size_t last) {
+    if (first >= last)
+        return nullptr;
+
+    // The middle term of a sorted range becomes the root of its subtree
+    size_t middle = first + (last - first) / 2;
+    TermEntry entry = reader.entry(middle);
+
+    AVLNode* node = nodeArena.create<AVLNode>(dataArena, reader.key(entry));
+    node->frequency = static_cast<int>(entry.frequency);
+    node->postings.resize(entry.postingCount);
+    reader.readPostings(entry, node->postings.data());
+
+    node->left = buildBalanced(reader, first, middle);
+    node->right = buildBalanced(reader, middle + 1, last);
+    node->height = 1 + std::max(getHeight(node->left), getHeight(node->right));
+    return node;
 }
 
 void AVLTree::loadFromFile(const std::string& fileName) {
     // Clear the existing tree
     clear();
 
-    std::ifstream inFile(fileName);
-
-    if (!inFile.is_open()) {
-        std::cerr << "Error opening file for reading: " << fileName << std::endl;
+    IndexFileReader reader;
+    if (!reader.open(fileName)) {
         return;
     }
 
-    std::string word;
-    int frequency; // To store the frequency of the word
-    std::string document;
-
-    while (std::getline(inFile, word, ',') >> frequency) {
-        inFile.ignore();
-
-        std::string line;
-        std::getline(inFile >> std::ws, line);
-
-        std::vector<std::string> tokens = tokenize(line);
+    // The file is sorted, so the tree is built in O(n) without any rotations
+    root = buildBalanced(reader, 0, reader.termCount());
+}
 
-        for (const auto& token : tokens) {
-            insert(word,token);
-        }
+AVLNode* AVLTree::search(std::string_view word) const {
+    return searchNode(root, word);
+}
 
+std::vector<AVLNode*> AVLTree::search(const std::vector<std::string_view>& words) const {
+    // Sort the terms once so the whole batch can share a single descent
+    std::vector<std::pair<std::string_view, std::size_t>> sorted;
+    sorted.reserve(words.size());
+    for (std::size_t i = 0; i < words.size(); ++i) {
+        sorted.emplace_back(words[i], i);
     }
+    std::sort(sorted.begin(), sorted.end());
 
-    inFile.close();
+    std::vector<AVLNode*> result(words.size(), nullptr);
+    searchNodes(root, sorted.begin(), sorted.end(), result);
+    return result;
 }
 
-std::vector<AVLNode*> AVLTree::search(const std::string& word) {
-    std::vector<std::string> tokens = tokenize(word);
-    std::vector<AVLNode*> result;
-        for (const auto& token : tokens) {
-            std::vector<AVLNode*> tokenResult = searchNode(root, token);
-            result.insert(result.end(), tokenResult.begin(), tokenResult.end());
-        }
-
-    return result;  
+AVLNode* AVLTree::searchNode(AVLNode* node, std::string_view word) const {
+    while (node != nullptr) {
+        if (word < node->key)
+            node = node->left;
+        else if (word > node->key)
+            node = node->right;
+        else
+            return node;
+    }
+    // Word not found
+    return nullptr;
 }
 
-std::vector<AVLNode*> AVLTree::searchNode(AVLNode* node, const std::string& word) {
-    std::vector<AVLNode*> result;
+void AVLTree::searchNodes(AVLNode* node,
+                          std::vector<std::pair<std::string_view, std::size_t>>::const_iterator first,
+                          std::vector<std::pair<std::string_view, std::size_t>>::const_iterator last,
+                          std::vector<AVLNode*>& result) const {
+    if (node == nullptr || first == last)
+        return;
 
-    if (node == nullptr) {
-        // Word not found
-        return result;
-    }
+    // Split the batch around this node: smaller terms go left, larger go right
+    std::string_view key = node->key;
+    auto lower = std::lower_bound(first, last, key,
+        [](const auto& term, std::string_view k) { return term.first < k; });
+    auto upper = std::upper_bound(lower, last, key,
+        [](std::string_view k, const auto& term) { return k < term.first; });
 
-    if (word == node->key) {
-        // Word found in the current node
-        result.push_back(node);
+    for (auto it = lower; it != upper; ++it) {
+        result[it->second] = node;
     }
 
-    // Search in the left subtree
-    std::vector<AVLNode*> leftResult = searchNode(node->left, word);
-    result.insert(result.end(), leftResult.begin(), leftResult.end());
-
-    // Search in the right subtree
-    std::vector<AVLNode*> rightResult = searchNode(node->right, word);
-    result.insert(result.end(), rightResult.begin(), rightResult.end());
-
-    return result;
-}
\ No newline at end of file
+    searchNodes(node->left, first, lower, result);
+    searchNodes(node->right, upper, last, result);
+}
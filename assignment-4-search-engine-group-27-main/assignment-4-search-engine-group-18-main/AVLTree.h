@@ -2,42 +2,70 @@
 #ifndef AVLTREE_H
 #define AVLTREE_H
 
+#include <cstddef>
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
+#include "arena.h"
+#include "posting.h"
 
+class IndexFileWriter;
+class IndexFileReader;
+
+// Nodes live in the tree's arena and are never destroyed individually:
+// the key and the posting buffer are arena memory as well.
 struct AVLNode {
-    std::string key;
-    std::vector<std::string> documents;
+    std::string_view key;
+    PostingList postings; // sorted by docId
     int height;
-    int frequency;
+    int frequency; // total occurrences across all documents
     AVLNode* left;
     AVLNode* right;
 
-    AVLNode(const std::string& word, const std::string& document);
+    AVLNode(Arena& data, std::string_view word); // no postings yet
+    AVLNode(Arena& data, std::string_view word, uint32_t document, int count = 1);
 };
 
 class AVLTree {
 private:
     AVLNode* root;
+    Arena nodeArena; // only AVLNode objects, so nodes sit next to each other
+    Arena dataArena; // keys and posting buffers
 
     int getHeight(AVLNode* node);
     int getBalanceFactor(AVLNode* node);
     AVLNode* rotateRight(AVLNode* y);
     AVLNode* rotateLeft(AVLNode* x);
     AVLNode* balanceNode(AVLNode* node);
-    AVLNode* insertNode(AVLNode* node, const std::string& word, const std::string& document);
-    std::vector<AVLNode*> searchNode(AVLNode* node, const std::string& word);
-    void clear(AVLNode* node);
+    AVLNode* insertNode(AVLNode* node, std::string_view word, uint32_t document, int count);
+    AVLNode* searchNode(AVLNode* node, std::string_view word) const;
+    // Builds a perfectly balanced subtree from the sorted terms [first, last) of a file
+    AVLNode* buildBalanced(const IndexFileReader& reader, size_t first, size_t last);
+    // Resolves a sorted range of (term, query position) pairs in one descent
+    void searchNodes(AVLNode* node,
+                     std::vector<std::pair<std::string_view, std::size_t>>::const_iterator first,
+                     std::vector<std::pair<std::string_view, std::size_t>>::const_iterator last,
+                     std::vector<AVLNode*>& result) const;
 
 public:
     AVLTree();
-    void insert(const std::string& word, const std::string& document);
+    AVLTree(const AVLTree&) = delete;
+    AVLTree& operator=(const AVLTree&) = delete;
+    void insert(std::string_view word, uint32_t document, int count = 1);
+    // Inserts all terms of one document, touching the tree once per distinct term
+    void insertDocument(uint32_t document, std::vector<std::string_view> terms);
     void printInOrder();
-    void inOrderTraversal(AVLNode* node, std::ofstream& outFile);
-    void saveToFile(const std::string& fileName);
+    void inOrderTraversal(AVLNode* node, IndexFileWriter& writer);
+    bool saveToFile(const std::string& fileName);
     void loadFromFile(const std::string& fileName);
-    void clear(); // New function to clear the tree
-    std::vector<AVLNode*> search(const std::string& word);
+    void clear(); // O(1): rewinds the arenas
+    bool empty() const { return root == nullptr; }
+    // Bytes handed out by the arenas, i.e. what the tree currently costs
+    size_t memoryUsage() const { return nodeArena.bytesAllocated() + dataArena.bytesAllocated(); }
+    AVLNode* search(std::string_view word) const; // nullptr if the word is not indexed
+    std::vector<AVLNode*> search(const std::vector<std::string_view>& words) const; // one node (or nullptr) per word
     ~AVLTree(); // Destructor to ensure proper cleanup
     // Add other operations as needed
 };
@@ -0,0 +1,93 @@
+// arena.cpp
+#include "arena.h"
+#include <cstdint>
+#include <cstring>
+
+static constexpr size_t minimumBlockSize = 16;
+
+// Index of the smallest power of two that holds bytes
+static size_t sizeClassOf(size_t bytes) {
+    size_t sizeClass = 0;
+    while ((minimumBlockSize << sizeClass) < bytes) {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
+
+Arena::Arena() : currentSlab(0), cursor(nullptr), end(nullptr), freeBlocks(), bytesInUse(0) {}
+
+Arena::~Arena() {
+    for (const Slab& slab : slabs) {
+        ::operator delete(slab.memory);
+    }
+}
+
+void Arena::nextSlab(size_t bytes) {
+    // Reuse slabs left over from before the last reset when they are big enough
+    size_t next = cursor == nullptr ? 0 : currentSlab + 1;
+    while (next < slabs.size() && slabs[next].size < bytes) {
+        ++next;
+    }
+
+    if (next == slabs.size()) {
+        size_t size = bytes > defaultSlabSize ? bytes : defaultSlabSize;
+        slabs.push_back({static_cast<char*>(::operator new(size)), size});
+    }
+
+    currentSlab = next;
+    cursor = slabs[next].memory;
+    end = cursor + slabs[next].size;
+}
+
+void* Arena::allocate(size_t bytes, size_t alignment) {
+    uintptr_t address = reinterpret_cast<uintptr_t>(cursor);
+    size_t padding = (alignment - address % alignment) % alignment;
+
+    if (cursor == nullptr || static_cast<size_t>(end - cursor) < padding + bytes) {
+        nextSlab(bytes + alignment);
+        address = reinterpret_cast<uintptr_t>(cursor);
+        padding = (alignment - address % alignment) % alignment;
+    }
+
+    void* result = cursor + padding;
+    cursor += padding + bytes;
+    bytesInUse += padding + bytes;
+    return result;
+}
+
+void* Arena::allocateBlock(size_t bytes) {
+    size_t sizeClass = sizeClassOf(bytes);
+    if (sizeClass < sizeClasses && freeBlocks[sizeClass] != nullptr) {
+        void* block = freeBlocks[sizeClass];
+        std::memcpy(&freeBlocks[sizeClass], block, sizeof(void*));
+        return block;
+    }
+    return allocate(minimumBlockSize << sizeClass, alignof(std::max_align_t));
+}
+
+void Arena::deallocateBlock(void* block, size_t bytes) {
+    size_t sizeClass = sizeClassOf(bytes);
+    if (block == nullptr || sizeClass >= sizeClasses) {
+        return;
+    }
+    // The first bytes of a freed block link it into its size class list
+    std::memcpy(block, &freeBlocks[sizeClass], sizeof(void*));
+    freeBlocks[sizeClass] = block;
+}
+
+std::string_view Arena::copyString(std::string_view text) {
+    char* copy = static_cast<char*>(allocate(text.size(), 1));
+    std::memcpy(copy, text.data(), text.size());
+    return std::string_view(copy, text.size());
+}
+
+void Arena::reset() {
+    // Forget everything handed out so far; the slabs stay allocated for reuse
+    currentSlab = 0;
+    cursor = slabs.empty() ? nullptr : slabs[0].memory;
+    end = slabs.empty() ? nullptr : cursor + slabs[0].size;
+    for (void*& block : freeBlocks) {
+        block = nullptr;
+    }
+    bytesInUse = 0;
+}
@@ -0,0 +1,86 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Bump allocator that hands out memory from large slabs. Nothing is freed
+// individually: reset() rewinds to the first slab in O(1) and keeps the slabs
+// for reuse, so objects placed here must not need their destructors run.
+class Arena {
+private:
+    struct Slab {
+        char* memory;
+        size_t size;
+    };
+
+    static constexpr size_t defaultSlabSize = 1 << 20;
+    static constexpr size_t sizeClasses = 48;
+
+    std::vector<Slab> slabs;
+    size_t currentSlab;
+    char* cursor;
+    char* end;
+    void* freeBlocks[sizeClasses]; // recycled blocks, one list per power of two
+    size_t bytesInUse;
+
+    void nextSlab(size_t bytes);
+
+public:
+    Arena();
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+    // Power-of-two sized blocks that can be handed back for reuse (container buffers)
+    void* allocateBlock(size_t bytes);
+    void deallocateBlock(void* block, size_t bytes);
+
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    std::string_view copyString(std::string_view text);
+
+    void reset();
+    size_t bytesAllocated() const { return bytesInUse; }
+};
+
+// Standard allocator adapter so containers can keep their buffers in an Arena
+template <typename T>
+class ArenaAllocator {
+private:
+    Arena* arena;
+
+    template <typename U>
+    friend class ArenaAllocator;
+
+public:
+    using value_type = T;
+
+    explicit ArenaAllocator(Arena* arena) : arena(arena) {}
+
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : arena(other.arena) {}
+
+    T* allocate(size_t n) {
+        return static_cast<T*>(arena->allocateBlock(n * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t n) {
+        arena->deallocateBlock(pointer, n * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return arena == other.arena; }
+
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return arena != other.arena; }
+};
+
+#endif // ARENA_H
@@ -0,0 +1,119 @@
+// article_pack.cpp
+#include "article_pack.h"
+#include <cstring>
+#include <iostream>
+
+static constexpr char articlePackMagic[8] = {'S', 'S', 'P', 'A', 'C', 'K', '\0', '\0'};
+static constexpr uint32_t articlePackVersion = 1;
+
+ArticlePackWriter::ArticlePackWriter() : articlesSize(0) {}
+
+bool ArticlePackWriter::open(const std::string& name) {
+    fileName = name;
+    entries.clear();
+    paths.clear();
+    articlesSize = 0;
+
+    out.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error opening file for writing: " << fileName << std::endl;
+        return false;
+    }
+    // The header is rewritten once the sizes are known
+    ArticlePackHeader header{};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return static_cast<bool>(out);
+}
+
+void ArticlePackWriter::add(std::string_view path, std::string_view article) {
+    entries.push_back({articlesSize, paths.size(), static_cast<uint32_t>(article.size()),
+                       static_cast<uint32_t>(path.size())});
+    out.write(article.data(), static_cast<std::streamsize>(article.size()));
+    articlesSize += article.size();
+    paths.append(path);
+}
+
+bool ArticlePackWriter::close() {
+    ArticlePackHeader header{};
+    std::memcpy(header.magic, articlePackMagic, sizeof(header.magic));
+    header.version = articlePackVersion;
+    header.count = static_cast<uint32_t>(entries.size());
+    header.articlesOffset = sizeof(ArticlePackHeader);
+    header.entriesOffset = header.articlesOffset + articlesSize;
+    header.pathsOffset = header.entriesOffset + entries.size() * sizeof(ArticlePackEntry);
+    header.fileSize = header.pathsOffset + paths.size();
+
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(ArticlePackEntry));
+    out.write(paths.data(), static_cast<std::streamsize>(paths.size()));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+
+    if (!out) {
+        std::cerr << "Error writing article pack: " << fileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+ArticlePack::ArticlePack() : header{}, articles(nullptr), entries(nullptr), paths(nullptr) {}
+
+bool ArticlePack::open(const std::string& fileName) {
+    close();
+    if (!file.open(fileName)) {
+        return false;
+    }
+
+    if (file.size() >= sizeof(header)) {
+        std::memcpy(&header, file.data(), sizeof(header));
+    }
+    // A truncated pack fails the size check, sections must lie in order inside the file
+    if (file.size() < sizeof(header) ||
+        std::memcmp(header.magic, articlePackMagic, sizeof(header.magic)) != 0 ||
+        header.version != articlePackVersion || header.fileSize != file.size() ||
+        header.articlesOffset < sizeof(header) || header.entriesOffset < header.articlesOffset ||
+        header.pathsOffset < header.entriesOffset ||
+        header.pathsOffset - header.entriesOffset != header.count * sizeof(ArticlePackEntry) ||
+        header.fileSize < header.pathsOffset) {
+        std::cerr << "Not a supported article pack: " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    articles = file.data() + header.articlesOffset;
+    entries = file.data() + header.entriesOffset;
+    paths = file.data() + header.pathsOffset;
+    // Indexing reads the articles once, front to back
+    file.adviseSequential();
+    return true;
+}
+
+void ArticlePack::close() {
+    file.close();
+    header = ArticlePackHeader{};
+    articles = entries = paths = nullptr;
+}
+
+ArticlePackEntry ArticlePack::entry(size_t index) const {
+    ArticlePackEntry result;
+    std::memcpy(&result, entries + index * sizeof(ArticlePackEntry), sizeof(ArticlePackEntry));
+    return result;
+}
+
+std::string_view ArticlePack::article(size_t index) const {
+    ArticlePackEntry item = entry(index);
+    return std::string_view(articles + item.articleOffset, item.articleLength);
+}
+
+std::string_view ArticlePack::path(size_t index) const {
+    ArticlePackEntry item = entry(index);
+    return std::string_view(paths + item.pathOffset, item.pathLength);
+}
+
+bool ArticlePack::isPack(const std::string& fileName) {
+    // Anything shorter than a header cannot be opened, so it is not taken for a pack
+    std::ifstream in(fileName, std::ios::binary);
+    ArticlePackHeader header{};
+    return in.read(reinterpret_cast<char*>(&header), sizeof(header)) &&
+           std::memcmp(header.magic, articlePackMagic, sizeof(header.magic)) == 0;
+}
@@ -0,0 +1,80 @@
+#ifndef ARTICLE_PACK_H
+#define ARTICLE_PACK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "mapped_file.h"
+
+// A corpus packed into one file by "supersearch pack", so re-indexing reads
+// it front to back instead of walking the directory and opening every
+// article. Layout (all integers in host byte order):
+//
+//   ArticlePackHeader
+//   articles  the raw JSON of every article, back to back
+//   entries   count ArticlePackEntry records, in the order they were packed
+//   paths     the original path of every article, back to back
+//
+// Articles are appended as they are read and the table follows them, so the
+// writer never seeks back into the data.
+
+struct ArticlePackHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t articlesOffset;
+    uint64_t entriesOffset;
+    uint64_t pathsOffset;
+    uint64_t fileSize;
+};
+
+struct ArticlePackEntry {
+    uint64_t articleOffset; // relative to ArticlePackHeader::articlesOffset
+    uint64_t pathOffset;    // relative to ArticlePackHeader::pathsOffset
+    uint32_t articleLength;
+    uint32_t pathLength;
+};
+
+class ArticlePackWriter {
+private:
+    std::ofstream out;
+    std::string fileName;
+    std::vector<ArticlePackEntry> entries;
+    std::string paths;
+    uint64_t articlesSize;
+
+public:
+    ArticlePackWriter();
+    bool open(const std::string& fileName);
+    void add(std::string_view path, std::string_view article);
+    bool close();
+};
+
+// Read-only view of a memory-mapped pack
+class ArticlePack {
+private:
+    MappedFile file;
+    ArticlePackHeader header;
+    const char* articles;
+    const char* entries;
+    const char* paths;
+
+    ArticlePackEntry entry(size_t index) const;
+
+public:
+    ArticlePack();
+    bool open(const std::string& fileName);
+    void close();
+
+    size_t size() const { return header.count; }
+    std::string_view article(size_t index) const;
+    std::string_view path(size_t index) const;
+
+    // Whether fileName starts like a pack, so callers can tell it from a directory
+    static bool isPack(const std::string& fileName);
+};
+
+#endif // ARTICLE_PACK_H
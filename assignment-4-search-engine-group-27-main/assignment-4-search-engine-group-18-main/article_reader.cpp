@@ -0,0 +1,203 @@
+// article_reader.cpp
+#include "article_reader.h"
+#include <cstring>
+#include <utility>
+
+void ArticleFields::clear() {
+    title = std::string_view();
+    url = std::string_view();
+    text = std::string_view();
+    organizations.clear();
+    persons.clear();
+}
+
+// Follows the path of the current value and records the wanted strings in
+// the fields. Only the first occurrence of a field counts, which is what
+// looking it up in a DOM would return.
+class ArticleHandler : public rapidjson::BaseReaderHandler<rapidjson::UTF8<>, ArticleHandler> {
+private:
+    // Containers on the way to an entity name
+    enum class Scope { Article, Entities, OrganizationList, PersonList, Organization, Person };
+    // What the last key announced
+    enum class Target { None, Title, Url, Text, Entities, Organizations, Persons, Name };
+
+    static constexpr size_t maxDepth = 4;
+
+    ArticleFields& fields;
+    Scope scopes[maxDepth];
+    size_t depth = 0;
+    size_t skipDepth = 0; // nesting inside a container nobody asked for
+    bool article = false; // the top-level value is an object
+    Target target = Target::None;
+    bool seenTitle = false;
+    bool seenUrl = false;
+    bool seenText = false;
+    bool seenEntities = false;
+    bool seenOrganizations = false;
+    bool seenPersons = false;
+    bool seenName = false;
+
+    static bool equals(const char* key, rapidjson::SizeType length, const char* name) {
+        return length == std::strlen(name) && std::memcmp(key, name, length) == 0;
+    }
+
+    // Enters a container, returns the scope it opens or false to skip it
+    bool enter(bool isObject, Scope& scope) {
+        Target announced = target;
+        target = Target::None;
+        if (skipDepth > 0)
+            return false;
+
+        if (depth == 0) {
+            scope = Scope::Article;
+            article = isObject;
+            return isObject;
+        }
+        switch (announced) {
+        case Target::Entities:
+            scope = Scope::Entities;
+            return isObject && !std::exchange(seenEntities, true);
+        case Target::Organizations:
+            scope = Scope::OrganizationList;
+            return !isObject && !std::exchange(seenOrganizations, true);
+        case Target::Persons:
+            scope = Scope::PersonList;
+            return !isObject && !std::exchange(seenPersons, true);
+        case Target::None:
+            // Elements of the entity lists
+            if (isObject && scopes[depth - 1] == Scope::OrganizationList) {
+                scope = Scope::Organization;
+                return true;
+            }
+            if (isObject && scopes[depth - 1] == Scope::PersonList) {
+                scope = Scope::Person;
+                return true;
+            }
+            return false;
+        default:
+            return false;
+        }
+    }
+
+    bool start(bool isObject) {
+        Scope scope;
+        if (enter(isObject, scope) && depth < maxDepth) {
+            scopes[depth++] = scope;
+            seenName = false;
+        } else {
+            ++skipDepth;
+        }
+        return true;
+    }
+
+    bool end() {
+        if (skipDepth > 0) {
+            --skipDepth;
+        } else {
+            --depth;
+        }
+        target = Target::None;
+        return true;
+    }
+
+    void appendName(std::string& names, const char* value, rapidjson::SizeType length) {
+        if (seenName)
+            return;
+        seenName = true;
+        if (!names.empty()) {
+            names.push_back('\n');
+        }
+        names.append(value, length);
+    }
+
+public:
+    explicit ArticleHandler(ArticleFields& fields) : fields(fields) {}
+
+    bool isArticle() const { return article; }
+
+    bool Default() {
+        target = Target::None;
+        return true;
+    }
+
+    bool Key(const char* key, rapidjson::SizeType length, bool) {
+        target = Target::None;
+        if (skipDepth > 0)
+            return true;
+
+        switch (scopes[depth - 1]) {
+        case Scope::Article:
+            if (equals(key, length, "text")) {
+                target = Target::Text;
+            } else if (equals(key, length, "title")) {
+                target = Target::Title;
+            } else if (equals(key, length, "url")) {
+                target = Target::Url;
+            } else if (equals(key, length, "entities")) {
+                target = Target::Entities;
+            }
+            break;
+        case Scope::Entities:
+            if (equals(key, length, "organizations")) {
+                target = Target::Organizations;
+            } else if (equals(key, length, "persons")) {
+                target = Target::Persons;
+            }
+            break;
+        case Scope::Organization:
+        case Scope::Person:
+            if (equals(key, length, "name")) {
+                target = Target::Name;
+            }
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool String(const char* value, rapidjson::SizeType length, bool) {
+        Target announced = target;
+        target = Target::None;
+        if (skipDepth > 0)
+            return true;
+
+        switch (announced) {
+        case Target::Title:
+            if (!std::exchange(seenTitle, true)) {
+                fields.title = std::string_view(value, length);
+            }
+            break;
+        case Target::Url:
+            if (!std::exchange(seenUrl, true)) {
+                fields.url = std::string_view(value, length);
+            }
+            break;
+        case Target::Text:
+            if (!std::exchange(seenText, true)) {
+                fields.text = std::string_view(value, length);
+            }
+            break;
+        case Target::Name:
+            appendName(scopes[depth - 1] == Scope::Organization ? fields.organizations : fields.persons, value, length);
+            break;
+        default:
+            break;
+        }
+        return true;
+    }
+
+    bool StartObject() { return start(true); }
+    bool EndObject(rapidjson::SizeType) { return end(); }
+    bool StartArray() { return start(false); }
+    bool EndArray(rapidjson::SizeType) { return end(); }
+};
+
+bool ArticleReader::parse(char* json, ArticleFields& fields) {
+    fields.clear();
+    ArticleHandler handler(fields);
+    rapidjson::InsituStringStream stream(json);
+    constexpr unsigned flags =
+        rapidjson::kParseInsituFlag | rapidjson::kParseStopWhenDoneFlag | rapidjson::kParseValidateEncodingFlag;
+    return !reader.Parse<flags>(stream, handler).IsError() && handler.isArticle();
+}
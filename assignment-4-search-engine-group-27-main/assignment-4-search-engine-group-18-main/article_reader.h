@@ -0,0 +1,39 @@
+#ifndef ARTICLE_READER_H
+#define ARTICLE_READER_H
+
+#include <string>
+#include <string_view>
+#include "rapidjson/reader.h"
+
+// The parts of an article the indexer uses. title, url and text view into
+// the buffer that was parsed, so they are valid as long as it is. Entity
+// names are joined with newlines, which the tokenizer treats as whitespace,
+// so one buffer per list is enough.
+struct ArticleFields {
+    std::string_view title;
+    std::string_view url;
+    std::string_view text;
+    std::string organizations; // entities.organizations[].name
+    std::string persons;       // entities.persons[].name
+
+    void clear();
+};
+
+// Streams an article through rapidjson's SAX reader and picks out only the
+// fields above. thread, social, highlightText and the rest are skipped as
+// they are read, so no DOM is built. The parse is in situ: strings are
+// unescaped in place and the fields point into the buffer instead of being
+// copied. Parsing stops where the article object ends, so a JSON Lines
+// record is parsed as it is, line break included. Meant to be reused: the
+// reader keeps its parse stack between articles.
+class ArticleReader {
+private:
+    rapidjson::Reader reader;
+
+public:
+    // json must be null-terminated and is modified. False if it does not start
+    // with a valid object; whatever follows the object is not looked at.
+    bool parse(char* json, ArticleFields& fields);
+};
+
+#endif // ARTICLE_READER_H
@@ -0,0 +1,188 @@
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+// What a queue saw during one run; stalls are the time producers waited for
+// a free slot (downstream too slow) and consumers waited for an element
+// (upstream too slow)
+struct QueueMetrics {
+    size_t capacity = 0;
+    uint64_t pushes = 0;
+    size_t maxDepth = 0;
+    double averageDepth = 0.0; // sampled at every push
+    double producerStallMs = 0.0;
+    double consumerStallMs = 0.0;
+};
+
+// Bounded multi-producer multi-consumer ring buffer. Every slot carries a
+// sequence number that tells producers and consumers whose turn it is, so
+// tryPush and tryPop are lock-free: one compare-and-swap on the shared
+// position, no mutex. push and pop wait by yielding and then sleeping
+// briefly, which keeps idle pipeline stages off the CPU.
+template <typename T>
+class BoundedQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePosition;
+    alignas(64) std::atomic<size_t> dequeuePosition;
+    alignas(64) std::atomic<bool> closed;
+
+    std::atomic<uint64_t> pushes;
+    std::atomic<uint64_t> depthSum;
+    std::atomic<size_t> maxDepth;
+    std::atomic<uint64_t> producerStallNs;
+    std::atomic<uint64_t> consumerStallNs;
+
+    static void backOff(unsigned& attempt) {
+        if (++attempt < 64) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    }
+
+    static uint64_t elapsedNs(std::chrono::steady_clock::time_point start) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    void recordDepth() {
+        size_t depth = size();
+        pushes.fetch_add(1, std::memory_order_relaxed);
+        depthSum.fetch_add(depth, std::memory_order_relaxed);
+        size_t seen = maxDepth.load(std::memory_order_relaxed);
+        while (depth > seen && !maxDepth.compare_exchange_weak(seen, depth, std::memory_order_relaxed)) {
+        }
+    }
+
+public:
+    // capacity is rounded up to a power of two
+    explicit BoundedQueue(size_t capacity)
+        : enqueuePosition(0), dequeuePosition(0), closed(false), pushes(0), depthSum(0),
+          maxDepth(0), producerStallNs(0), consumerStallNs(0) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells.reset(new Cell[size]);
+        mask = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    // Moves value in and returns true, or leaves it alone if the queue is full
+    bool tryPush(T& value) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false; // full
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool tryPop(T& value) {
+        size_t position = dequeuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+            if (difference == 0) {
+                if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false; // empty
+            } else {
+                position = dequeuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        value = std::move(cell->value);
+        cell->sequence.store(position + mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Waits while the queue is full
+    void push(T value) {
+        if (!tryPush(value)) {
+            auto start = std::chrono::steady_clock::now();
+            unsigned attempt = 0;
+            do {
+                backOff(attempt);
+            } while (!tryPush(value));
+            producerStallNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+        }
+        recordDepth();
+    }
+
+    // Waits while the queue is empty; false once it is closed and drained
+    bool pop(T& value) {
+        if (tryPop(value))
+            return true;
+
+        auto start = std::chrono::steady_clock::now();
+        unsigned attempt = 0;
+        bool popped;
+        while (!(popped = tryPop(value))) {
+            if (closed.load(std::memory_order_acquire)) {
+                // Everything was pushed before the close, so one more look is final
+                popped = tryPop(value);
+                break;
+            }
+            backOff(attempt);
+        }
+        consumerStallNs.fetch_add(elapsedNs(start), std::memory_order_relaxed);
+        return popped;
+    }
+
+    // Called once all producers are done
+    void close() { closed.store(true, std::memory_order_release); }
+
+    // Approximate while producers and consumers are running
+    size_t size() const {
+        size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+        size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    QueueMetrics metrics() const {
+        QueueMetrics result;
+        result.capacity = mask + 1;
+        result.pushes = pushes.load();
+        result.maxDepth = maxDepth.load();
+        result.averageDepth = result.pushes == 0 ? 0.0 : static_cast<double>(depthSum.load()) / result.pushes;
+        result.producerStallMs = producerStallNs.load() / 1e6;
+        result.consumerStallMs = consumerStallNs.load() / 1e6;
+        return result;
+    }
+};
+
+#endif // BOUNDED_QUEUE_H
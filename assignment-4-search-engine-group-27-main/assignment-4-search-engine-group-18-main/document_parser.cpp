@@ -11,262 +11,203 @@
 #include <codecvt>
 #include <sstream>
 #include <iterator>
+#include <algorithm>
+#include <cstring>
 
-// RapidJSON headers we need for our parsing.
-#include "rapidjson/istreamwrapper.h"
-#include "rapidjson/document.h"
 #include "english_stem.h"
+#include "fixed_string.h"
 #include "document_parser.h"
+#include "ingest_pipeline.h"
+#include "stem_cache.h"
+#include "article_pack.h"
+#include "json_lines_reader.h"
 
-
-using namespace rapidjson;
-using namespace std;
-
-int DocumentParser::totalArticlesProcessed = 0;
-int DocumentParser::totalUniqueWordsIndexed = 0;
-// // Function Prototypes
-void readJsonFiles(const string &fileName, AVLTree &mainIndex, AVLTree &organizationIndex, AVLTree &personsIndex);
-void readFileSystem(const string &path, AVLTree &mainIndex, AVLTree &organizationIndex, AVLTree &personsIndex);
-std::string cleanText(string &word);
-void loadMainIndex(const string &fileName, AVLTree &mainIndex);
-void loadOrganizationIndex(const string &fileName, AVLTree &organizationIndex);
-void loadPersonsIndex(const string &fileName, AVLTree &personsIndex);
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SUPERSEARCH_HAVE_POSIX_IO 1
+#endif
 
 
+using namespace std;
 
-std::string DocumentParser::applyStemming(const std::string& inputText) {
-    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
-    std::wstring stemmedText = converter.from_bytes(inputText);
-
-    stemming::english_stem<> StemEnglish;
+std::atomic<int> DocumentParser::totalArticlesProcessed{0};
+std::atomic<int> DocumentParser::totalUniqueWordsIndexed{0};
 
-    // Tokenize the input text into words
-    std::wstringstream wss(stemmedText);
-    std::vector<std::wstring> words{ std::istream_iterator<std::wstring, wchar_t>(wss),
-                                 std::istream_iterator<std::wstring, wchar_t>() };
 
-    // Apply stemming to each word
-    for (auto& word : words) {
-        StemEnglish(word);
+size_t DocumentParser::stemInto(std::string_view word, char* out) {
+    // Frequent words are answered from the cache without running the stemmer
+    thread_local StemCache cache;
+    size_t length;
+    if (cache.lookup(word, out, length)) {
+        return length;
     }
 
-    // Recreate the string with stemmed words
-    std::wstringstream result;
-    std::copy(words.begin(), words.end(), std::ostream_iterator<std::wstring, wchar_t>(result, L" "));
-
-    return converter.to_bytes(result.str());
-}
-
-std::string DocumentParser::removePunctuation(const std::string& inputText) {
-    std::string result;
+    bool ascii = std::all_of(word.begin(), word.end(), [](char ch) {
+        return static_cast<unsigned char>(ch) < 0x80;
+    });
+
+    if (ascii && word.size() <= maxStackStemLength) {
+        // Nearly every token: stemmed on the stack, the heap is never touched
+        thread_local stemming::english_stem<FixedString<maxStackStemLength>> stemStack;
+        FixedString<maxStackStemLength> text(word);
+        stemStack(text);
+        cache.insert(word, text.view());
+        length = text.size();
+        std::memcpy(out, text.data(), length);
+        return length;
+    }
 
-    for (char ch : inputText) {
-        // Check if the character is not a punctuation mark
-        if (!std::ispunct(ch)) {
-            result += ch;
+    thread_local std::string stem;
+    if (ascii) {
+        thread_local stemming::english_stem<std::string> stemBytes;
+        stem.assign(word.data(), word.size());
+        stemBytes(stem);
+    } else {
+        // The wide stemmer also folds full-width forms, so it handles everything else
+        thread_local stemming::english_stem<> stemEnglish;
+        thread_local std::wstring wideTerm;
+        // With error strings the converter reports bad input instead of throwing
+        std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter{std::string(), std::wstring()};
+        wideTerm = converter.from_bytes(word.data(), word.data() + word.size());
+        bool valid = converter.converted() == word.size();
+        if (valid) {
+            stemEnglish(wideTerm);
+            stem = converter.to_bytes(wideTerm);
+            valid = converter.converted() == wideTerm.size();
+        }
+        if (!valid) {
+            // Not UTF-8: indexed as it is rather than stemmed
+            stem.assign(word.data(), word.size());
         }
     }
-
-    return result;
+    cache.insert(word, stem);
+    std::memcpy(out, stem.data(), stem.size());
+    return stem.size();
 }
 
-std::string DocumentParser::removeStopWords(const std::string& inputText, const std::string& stopWordsFile) {
-    // Read stop words from the file into a vector
-    std::ifstream stopWordsStream(stopWordsFile);
-    if (!stopWordsStream.is_open()) {
-        std::cerr << "Error opening stop words file." << std::endl;
-        return inputText;  // Return the input text unchanged in case of an error
-    }
-
-   std::vector<std::string> stopWords;
-    std::string stopWord;
-    while (stopWordsStream >> stopWord) {
-        // Convert stop word to lowercase for case-insensitive comparison
-        std::transform(stopWord.begin(), stopWord.end(), stopWord.begin(), ::tolower);
-        stopWords.push_back(stopWord);
-    }
-    // Close the stop words file
-    stopWordsStream.close();
-
-    
-    // Tokenize the input text into words
-    std::istringstream iss(inputText);
-    std::vector<std::string> words(std::istream_iterator<std::string>{iss},
-                                   std::istream_iterator<std::string>());
-
-    // Remove stop words
-    words.erase(std::remove_if(words.begin(), words.end(), [&stopWords](const std::string& word) {
-        std::string lowerWord = word;
-        std::transform(lowerWord.begin(), lowerWord.end(), lowerWord.begin(), ::tolower);
-        bool isStopWord = std::find(stopWords.begin(), stopWords.end(), lowerWord) != stopWords.end();
-        return isStopWord;
-    }), words.end());
-
-    // Recreate the string without stop words
-    std::ostringstream result;
-    std::copy(words.begin(), words.end(), std::ostream_iterator<std::string>(result, " "));
-
-    return result.str();
+void DocumentParser::applyStemming(std::string& term) {
+    term.resize(stemInto(term, &term[0]));
 }
 
-std::string DocumentParser::cleanText(std::string& inputText) { 
-    inputText = removePunctuation(inputText);
-   inputText = removeStopWords(inputText,"stop_words_english.txt");
-    inputText = applyStemming(inputText);
+const StopWordSet& DocumentParser::getStopWords() {
+    // Function-local static: the file is read exactly once per process
+    static const StopWordSet stopWords = [] {
+        StopWordSet words;
+        words.loadFromFile("stop_words_english.txt");
+        return words;
+    }();
+    return stopWords;
+}
 
-    return inputText;
+std::string DocumentParser::cleanText(const std::string& inputText) {
+    std::string result;
+    tokenize(inputText, [&result](std::string_view term) {
+        result.append(term);
+        result.push_back(' ');
+    });
+    return result;
 }
 
 /**
- * example code that reads and parses a json file and extracts the title and person
- * entities.
+ * Loads a whole json file into memory, so the disk access is done before parsing starts.
  * @param fileName filename with relative or absolute path included.
+ * @param json receives the contents of the file followed by a null byte. Its
+ * capacity is reused, so a recycled buffer is only grown for larger files.
  */
-void DocumentParser::readJsonFiles(const string &fileName, AVLTree &mainIndex, AVLTree &organizationIndex, AVLTree &personsIndex)
+bool DocumentParser::readArticle(const string &fileName, std::vector<char> &json)
 {
-
-    // open an ifstream on the file of interest and check that it could be opened.
-    loadMainIndex(fileName, mainIndex);
-    loadOrganizationIndex(fileName, organizationIndex);
-    loadPersonsIndex(fileName, personsIndex);
-}
-
-void DocumentParser::loadMainIndex(const string &fileName, AVLTree &mainIndex) {
- ifstream input(fileName);
-    if (!input.is_open())
+#ifdef SUPERSEARCH_HAVE_POSIX_IO
+    // pread(2) straight into the buffer, no stream buffering in between
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0)
     {
         cerr << "cannot open file: " << fileName << endl;
-        return;
+        return false;
     }
 
-    // Create a RapidJSON IStreamWrapper using the file input stream above.
-    IStreamWrapper isw(input);
-
-    // Create a RapidJSON Document object and use it to parse the IStreamWrapper object above.
-    Document d;
-    d.ParseStream(isw);
-
-    // Now that the document is parsed, we can access different elements the JSON using
-    // familiar subscript notation.
-
-    // This accesses the -text- element in the JSON. Since the value
-    //  associated with text is a string (rather than
-    //  an array or something else), we call the GetString()
-    //  function to return the actual text of the article
-    //  as a c-string.
-    auto val = d["text"].GetString();    
-    
-    // auto valWithoutStopWords = removeStopWords(val,"stop_words_english.txt");//Remove all the stop words
-    // auto valNewPunct = removePunctuation(valWithoutStopWords);//Remove punctuation marks
-    // auto stemmedWords = applyStemming(valNewPunct);//Stem the text
-    // cout << "Text without stop words is: " << stemmedWords << "\n";
-    std::string textToClean = d["text"].GetString();
-    std::string cleaned = cleanText(textToClean);
-
-    std::istringstream iss(cleaned);
-    std::string word;
-    while (iss >> word) {
-        mainIndex.insert(word, fileName);//insert into the index
-        DocumentParser::totalUniqueWordsIndexed++;
+    struct stat info;
+    bool ok = fstat(fd, &info) == 0;
+    size_t size = ok ? static_cast<size_t>(info.st_size) : 0;
+    json.resize(size + 1);
+    size_t done = 0;
+    while (ok && done < size)
+    {
+        ssize_t count = ::pread(fd, json.data() + done, size - done, static_cast<off_t>(done));
+        ok = count > 0;
+        done += ok ? static_cast<size_t>(count) : 0;
     }
-    mainIndex.saveToFile("mainIndex.txt");
-    mainIndex.clear();
-}
-
-void DocumentParser::loadOrganizationIndex(const string &fileName, AVLTree &organizationIndex) {
- ifstream input(fileName);
+    ::close(fd);
+    if (!ok)
+    {
+        cerr << "cannot read file: " << fileName << endl;
+        return false;
+    }
+#else
+    // open an ifstream on the file of interest and check that it could be opened.
+    ifstream input(fileName, ios::binary);
     if (!input.is_open())
     {
         cerr << "cannot open file: " << fileName << endl;
-        return;
+        return false;
     }
 
-    // Create a RapidJSON IStreamWrapper using the file input stream above.
-    IStreamWrapper isw(input);
-
-    // Create a RapidJSON Document object and use it to parse the IStreamWrapper object above.
-    Document d;
-    d.ParseStream(isw);
-
-    // Now that the document is parsed, we can access different elements the JSON using
-    // familiar subscript notation.
-
-    // This accesses the -text- element in the JSON. Since the value
-    //  associated with text is a string (rather than
-    //  an array or something else), we call the GetString()
-    //  function to return the actual text of the article
-    //  as a c-string.
-     auto orgs = d["entities"]["organizations"].GetArray();
-
-    // We iterate over the Array returned from the line above.
-    //  Each element kind of operates like a little JSON document
-    //  object in that you can use the same subscript notation
-    //  to access particular values.
-    for (auto &o : orgs)
+    input.seekg(0, ios::end);
+    size_t size = static_cast<size_t>(input.tellg());
+    json.resize(size + 1);
+    input.seekg(0, ios::beg);
+    if (!input.read(json.data(), static_cast<streamsize>(size)))
     {
-        // cout << "    > " << setw(30) << left << o["name"].GetString()
-        //      << setw(10) << left << o["sentiment"].GetString() << "\n";
-        std::string textToClean = o["name"].GetString();
-        std::string cleaned = cleanText(textToClean);
-        std::istringstream iss(cleaned);
-        std::string word;
-        while (iss >> word) {
-            organizationIndex.insert(word, fileName);
-            DocumentParser::totalUniqueWordsIndexed++;
-        }
-        // organizationIndex.insert(cleaned, fileName);     
+        cerr << "cannot read file: " << fileName << endl;
+        return false;
     }
-
-    organizationIndex.saveToFile("organizationIndex.txt");
-    organizationIndex.clear();
+#endif
+    json[size] = '\0';
+    return true;
 }
 
-void DocumentParser::loadPersonsIndex(const string &fileName, AVLTree &personsIndex) {
- ifstream input(fileName);
-    if (!input.is_open())
+/**
+ * Parses an article once, the three indices share the extracted fields.
+ * @param json contents of the file, null-terminated; parsed in place, so the
+ * fields stay valid only as long as json is not changed.
+ * @param fileName only used for error messages.
+ */
+bool DocumentParser::parseArticle(std::vector<char> &json, const string &fileName, ArticleFields &article)
+{
+    // SAX parse: only the fields we index are picked out, no DOM is built
+    thread_local ArticleReader reader;
+    if (!reader.parse(json.data(), article))
     {
-        cerr << "cannot open file: " << fileName << endl;
-        return;
+        cerr << "cannot parse file: " << fileName << endl;
+        return false;
     }
+    return true;
+}
 
-    // Create a RapidJSON IStreamWrapper using the file input stream above.
-    IStreamWrapper isw(input);
+void DocumentParser::loadMetadata(const ArticleFields &fields, uint32_t docId, DocumentTable &documents) {
+    // Title and URL are only needed for the result page, keep them in the document table
+    documents.setMetadata(docId, fields.title, fields.url);
+}
 
-    // Create a RapidJSON Document object and use it to parse the IStreamWrapper object above.
-    Document d;
-    d.ParseStream(isw);
+void DocumentParser::analyzeArticle(const ArticleFields &fields, uint32_t docId, DocumentTable &documents, AnalyzedArticle &article) {
+    article.docId = docId;
 
-    // Now that the document is parsed, we can access different elements the JSON using
-    // familiar subscript notation.
+    tokenize(fields.text, article.text);
+    documents.setLength(docId, static_cast<uint32_t>(article.text.size()));
 
-    // This accesses the -text- element in the JSON. Since the value
-    //  associated with text is a string (rather than
-    //  an array or something else), we call the GetString()
-    //  function to return the actual text of the article
-    //  as a c-string.
-     auto orgs = d["entities"]["persons"].GetArray();
+    // Names are separated by newlines, so no term runs from one name into the next
+    tokenize(fields.organizations, article.organizations);
+    tokenize(fields.persons, article.persons);
 
-    // We iterate over the Array returned from the line above.
-    //  Each element kind of operates like a little JSON document
-    //  object in that you can use the same subscript notation
-    //  to access particular values.
-    for (auto &o : orgs)
-    {
-        // cout << "    > " << setw(30) << left << o["name"].GetString()
-        //      << setw(10) << left << o["sentiment"].GetString() << "\n";
-        std::string textToClean = o["name"].GetString();
-        std::string cleaned = cleanText(textToClean);
-        std::istringstream iss(cleaned);
-        std::string word;
-        while (iss >> word) {
-            personsIndex.insert(word, fileName);
-            DocumentParser::totalUniqueWordsIndexed++;
-        }
-        // personsIndex.insert(cleaned, fileName);     
-    }
+    DocumentParser::totalUniqueWordsIndexed += article.text.size() + article.organizations.size() + article.persons.size();
+}
 
-    personsIndex.saveToFile("personIndex.txt");
-    personsIndex.clear();
+void DocumentParser::indexArticle(const AnalyzedArticle &article, PartialIndex &index) {
+    index.mainIndex.insertDocument(article.docId, article.text.views());
+    index.organizationIndex.insertDocument(article.docId, article.organizations.views());
+    index.personsIndex.insertDocument(article.docId, article.persons.views());
+    DocumentParser::totalArticlesProcessed++;
 }
 
 /**
@@ -275,27 +216,129 @@ void DocumentParser::loadPersonsIndex(const string &fileName, AVLTree &personsIn
  *
  * @param path an absolute or relative path to a folder containing files
  * you want to parse.
+ * @param files receives the path of every .json file below path, in directory order.
  */
-void DocumentParser::readFileSystem(const string &path, AVLTree &mainIndex, AVLTree &organizationIndex, AVLTree &personsIndex)
+bool DocumentParser::listArticles(const string &path, std::vector<std::string> &files)
 {
+    files.clear();
+    std::error_code error;
+    if (!filesystem::is_directory(path, error))
+    {
+        cerr << "not a directory: " << path << endl;
+        return false;
+    }
 
     // recursive_director_iterator used to "access" folder at parameter -path-
     // we are using the recursive iterator so it will go into subfolders.
     // see: https://en.cppreference.com/w/cpp/filesystem/recursive_directory_iterator
-    auto it = filesystem::recursive_directory_iterator(path);
+    // The error_code overloads report an unreadable folder instead of throwing.
+    for (auto it = filesystem::recursive_directory_iterator(path, error);
+         !error && it != filesystem::recursive_directory_iterator(); it.increment(error))
+    {
+        // We only want to attempt to parse files that end with .json...
+        if (it->is_regular_file(error) && it->path().extension().string() == ".json")
+        {
+            files.push_back(it->path().string());
+        }
+    }
+    if (error)
+    {
+        cerr << "cannot read directory: " << path << " (" << error.message() << ")" << endl;
+        return false;
+    }
+    return true;
+}
 
-    // loop over all the entries.
-    for (const auto &entry : it)
+/**
+ * @param path folder to index, see listArticles.
+ * @param documents table that assigns each parsed file its document ID.
+ * @param pipeline runs the read, parse, analyze and index stages.
+ */
+bool DocumentParser::readFileSystem(const string &path, std::vector<std::unique_ptr<PartialIndex>> &partials, DocumentTable &documents, IngestPipeline &pipeline)
+{
+    std::vector<std::string> files;
+    if (!listArticles(path, files))
     {
+        return false;
+    }
 
-        // cout << "--- " << setw(60) << left << entry.path().c_str() << " ---" << endl;
+    // The walk itself is cheap: register every article first, so the IDs do not
+    // depend on which thread gets to a file first and the table never grows
+    // while the workers write into it.
+    for (const string &file : files)
+    {
+        documents.addDocument(file);
+    }
 
-        // We only want to attempt to parse files that end with .json...
-        if (entry.is_regular_file() && entry.path().extension().string() == ".json")
+    pipeline.run(documents, partials);
+    return true;
+}
+
+bool DocumentParser::readPack(const string &packFile, std::vector<std::unique_ptr<PartialIndex>> &partials, DocumentTable &documents, IngestPipeline &pipeline)
+{
+    ArticlePack pack;
+    if (!pack.open(packFile))
+    {
+        return false;
+    }
+
+    // Same IDs and paths as indexing the directory that was packed
+    for (size_t i = 0; i < pack.size(); ++i)
+    {
+        documents.addDocument(std::string(pack.path(i)));
+    }
+
+    pipeline.run(documents, partials, [&pack](size_t index) { return pack.article(index); });
+    return true;
+}
+
+bool DocumentParser::readJsonLines(const string &feedFile, std::vector<std::unique_ptr<PartialIndex>> &partials, DocumentTable &documents, IngestPipeline &pipeline)
+{
+    JsonLinesReader feed;
+    if (!feed.open(feedFile))
+    {
+        return false;
+    }
+
+    // The feed size is not known up front, so records are registered as they
+    // are read, in feed order, while the other stages work on earlier ones
+    JsonRecord record;
+    pipeline.runStream(documents, partials, [&](uint32_t &docId, std::vector<char> &json) {
+        if (!feed.next(record))
         {
-            readJsonFiles(entry.path().string(), mainIndex, organizationIndex, personsIndex);
-            DocumentParser::totalArticlesProcessed++;
+            return false;
         }
-    }
+        docId = documents.addDocument(feed.getName() + ":" + std::to_string(record.offset));
+        json.assign(record.json.begin(), record.json.end());
+        json.push_back('\0'); // the parser works in place on its own copy
+        return true;
+    });
+    // A feed cut short by a read error would leave an index that silently misses articles
+    return !feed.failed();
 }
 
+bool DocumentParser::packFileSystem(const string &path, const string &packFile)
+{
+    std::vector<std::string> files;
+    if (!listArticles(path, files))
+    {
+        return false;
+    }
+
+    ArticlePackWriter writer;
+    if (!writer.open(packFile))
+    {
+        return false;
+    }
+
+    std::vector<char> json;
+    for (const string &file : files)
+    {
+        // Unreadable files are reported and left out, as when indexing
+        if (readArticle(file, json))
+        {
+            writer.add(file, std::string_view(json.data(), json.size() - 1));
+        }
+    }
+    return writer.close();
+}
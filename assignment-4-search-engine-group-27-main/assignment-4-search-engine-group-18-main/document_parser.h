@@ -2,32 +2,157 @@
 #define DOCUMENT_PARSER_H
 
 #include <string>
-#include "AVLTree.h"
+#include <string_view>
+#include <cstdint>
+#include <cctype>
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+#include "article_reader.h"
+#include "index_builder.h"
+#include "document_table.h"
+#include "stop_word_set.h"
+
+// Terms of one field packed into a single buffer, so collecting them does not
+// allocate a string per term. views() stays valid until the next add or clear.
+class TermBuffer {
+private:
+    std::string characters;
+    std::vector<std::pair<size_t, size_t>> spans; // offset, length
+
+public:
+    void operator()(std::string_view term) {
+        spans.emplace_back(characters.size(), term.size());
+        characters.append(term);
+    }
+
+    std::vector<std::string_view> views() const {
+        std::vector<std::string_view> result;
+        result.reserve(spans.size());
+        for (const auto& [offset, length] : spans) {
+            result.emplace_back(characters.data() + offset, length);
+        }
+        return result;
+    }
+
+    size_t size() const { return spans.size(); }
+
+    void clear() {
+        characters.clear();
+        spans.clear();
+    }
+};
+
+// Terms of one article, ready to be added to the three indices
+struct AnalyzedArticle {
+    uint32_t docId = 0;
+    TermBuffer text;
+    TermBuffer organizations;
+    TermBuffer persons;
+};
+
+class IngestPipeline;
 
 class DocumentParser {
 private:
-    static int totalArticlesProcessed;
-    static int totalUniqueWordsIndexed;
+    // Updated by every indexing thread
+    static std::atomic<int> totalArticlesProcessed;
+    static std::atomic<int> totalUniqueWordsIndexed;
 public:
-    static void readJsonFiles(const std::string &fileName, AVLTree &mainIndex, AVLTree &organizationIndex, AVLTree &personsIndex);
-    static void loadMainIndex(const std::string &fileName, AVLTree &mainIndex);
-    static void loadOrganizationIndex(const std::string &fileName, AVLTree &organizationIndex);
-    static void loadPersonsIndex(const std::string &fileName, AVLTree &personsIndex);
+    // One function per ingestion stage, see IngestPipeline
+    static bool readArticle(const std::string &fileName, std::vector<char> &json);
+    static bool parseArticle(std::vector<char> &json, const std::string &fileName, ArticleFields &article);
+    static void loadMetadata(const ArticleFields &fields, uint32_t docId, DocumentTable &documents);
+    static void analyzeArticle(const ArticleFields &fields, uint32_t docId, DocumentTable &documents, AnalyzedArticle &article);
+    static void indexArticle(const AnalyzedArticle &article, PartialIndex &index);
 
-    static std::string applyStemming(const std::string& inputText);
-    static std::string removePunctuation(const std::string& inputText);
-    static std::string removeStopWords(const std::string& inputText, const std::string& stopWordsFile);
-    static std::string cleanText(std::string& inputText);
+    // Longest word stemmed in a stack buffer, longer words go through std::string
+    static constexpr size_t maxStackStemLength = 64;
+    // Writes the stem of a lowercase word to out and returns its length. A stem
+    // is never longer than its word, so out needs word.size() bytes; it may
+    // alias word. Cached and ASCII words do not allocate. A word that is not
+    // valid UTF-8 is its own stem.
+    static size_t stemInto(std::string_view word, char* out);
+    // Stems one lowercase term in place
+    static void applyStemming(std::string& term);
+    // Loaded from stop_words_english.txt once, on first use
+    static const StopWordSet& getStopWords();
+    // Single pass over text: lowercases, strips punctuation, drops stop words,
+    // stems and calls emit(std::string_view) once per remaining term
+    template <typename Callback>
+    static void tokenize(std::string_view text, Callback &&emit);
+    // Cleaned terms of text joined by spaces, used for query terms
+    static std::string cleanText(const std::string& inputText);
 
-    static void readFileSystem(const std::string &path, AVLTree &mainIndex, AVLTree &organizationIndex, AVLTree &personsIndex);
+    // Every .json file below path, in the order both indexing and packing use.
+    // False if path is not a directory or cannot be walked.
+    static bool listArticles(const std::string &path, std::vector<std::string> &files);
+    // Indexes every .json file below path through pipeline, one index thread per partial index.
+    // Document IDs follow the directory order, whichever thread parses the file.
+    static bool readFileSystem(const std::string &path, std::vector<std::unique_ptr<PartialIndex>> &partials, DocumentTable &documents, IngestPipeline &pipeline);
+    // Same for the articles of a pack written by packFileSystem, read front to back
+    static bool readPack(const std::string &packFile, std::vector<std::unique_ptr<PartialIndex>> &partials, DocumentTable &documents, IngestPipeline &pipeline);
+    // Same for the records of a JSON Lines feed ("-" for stdin), read through
+    // a rolling buffer in a single pipeline run. A record's path is the
+    // feed name and its byte offset, e.g. feed.jsonl:1234. False if the feed
+    // cannot be opened or a read fails.
+    static bool readJsonLines(const std::string &feedFile, std::vector<std::unique_ptr<PartialIndex>> &partials, DocumentTable &documents, IngestPipeline &pipeline);
+    // Copies every .json file below path into one pack file
+    static bool packFileSystem(const std::string &path, const std::string &packFile);
 
     static int getTotalArticlesProcessed() {
-        return totalArticlesProcessed;
+        return totalArticlesProcessed.load();
     }
 
     static int getTotalUniqueWordsIndexed() {
-        return totalUniqueWordsIndexed;
+        return totalUniqueWordsIndexed.load();
+    }
+
+    // Called before each index build, the ui may build more than one
+    static void resetCounters() {
+        totalArticlesProcessed = 0;
+        totalUniqueWordsIndexed = 0;
     }
 };
 
+template <typename Callback>
+void DocumentParser::tokenize(std::string_view text, Callback &&emit) {
+    const StopWordSet& stopWords = getStopWords();
+    // Reused for every token, so after warm-up nothing is allocated
+    thread_local std::string term;
+
+    auto isSpace = [](unsigned char ch) {
+        return ch == ' ' || (ch >= '\t' && ch <= '\r');
+    };
+
+    size_t i = 0;
+    while (i < text.size()) {
+        while (i < text.size() && isSpace(text[i])) {
+            ++i;
+        }
+
+        term.clear();
+        while (i < text.size() && !isSpace(text[i])) {
+            unsigned char ch = text[i++];
+            // Bytes of multi-byte UTF-8 sequences are kept as they are
+            if (ch < 0x80) {
+                if (std::ispunct(ch)) {
+                    continue;
+                }
+                ch = static_cast<unsigned char>(std::tolower(ch));
+            }
+            term.push_back(static_cast<char>(ch));
+        }
+
+        if (term.empty() || stopWords.contains(term)) {
+            continue;
+        }
+        applyStemming(term);
+        if (!term.empty()) {
+            emit(std::string_view(term));
+        }
+    }
+}
+
 #endif // DOCUMENT_PARSER_H
@@ -0,0 +1,200 @@
+// document_table.cpp
+#include "document_table.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+
+static constexpr char documentTableMagic[8] = {'S', 'S', 'D', 'O', 'C', 'S', '\0', '\0'};
+static constexpr uint32_t documentTableVersion = 3;
+
+uint32_t DocumentTable::addDocument(const std::string& path) {
+    std::unique_lock<std::shared_mutex> lock(growing);
+    documents.push_back({path, "", "", 0});
+    return static_cast<uint32_t>(documents.size() - 1);
+}
+
+DocumentInfo& DocumentTable::building(uint32_t id) {
+    std::shared_lock<std::shared_mutex> lock(growing);
+    return documents[id];
+}
+
+const DocumentInfo& DocumentTable::building(uint32_t id) const {
+    std::shared_lock<std::shared_mutex> lock(growing);
+    return documents[id];
+}
+
+void DocumentTable::setMetadata(uint32_t id, std::string_view title, std::string_view url) {
+    DocumentInfo& document = building(id);
+    document.title.assign(title.data(), title.size());
+    document.url.assign(url.data(), url.size());
+    document.indexed = true;
+}
+
+void DocumentTable::setLength(uint32_t id, uint32_t length) {
+    building(id).length = length;
+}
+
+uint64_t DocumentTable::lengthSum() const {
+    if (file.isOpen()) {
+        return totalLength;
+    }
+    uint64_t sum = 0;
+    for (const DocumentInfo& document : documents) {
+        sum += document.length;
+    }
+    return sum;
+}
+
+DocumentRecord DocumentTable::record(uint32_t id) const {
+    DocumentRecord result{};
+    if (id >= mappedCount) {
+        std::cerr << "Document ID " << id << " is not in the document table" << std::endl;
+        return result;
+    }
+    std::memcpy(&result, records + static_cast<size_t>(id) * sizeof(DocumentRecord), sizeof(DocumentRecord));
+    return result;
+}
+
+DocumentInfo DocumentTable::get(uint32_t id) const {
+    if (!file.isOpen()) {
+        return documents[id];
+    }
+
+    DocumentRecord entry = record(id);
+    uint64_t textLength = static_cast<uint64_t>(entry.pathLength) + entry.titleLength + entry.urlLength;
+    if (entry.stringsOffset > stringsSize || textLength > stringsSize - entry.stringsOffset) {
+        std::cerr << "Document " << id << " points outside the document table" << std::endl;
+        return DocumentInfo();
+    }
+    const char* text = strings + entry.stringsOffset;
+    DocumentInfo document;
+    document.path.assign(text, entry.pathLength);
+    document.title.assign(text + entry.pathLength, entry.titleLength);
+    document.url.assign(text + entry.pathLength + entry.titleLength, entry.urlLength);
+    document.length = entry.length;
+    return document;
+}
+
+uint32_t DocumentTable::getLength(uint32_t id) const {
+    return file.isOpen() ? record(id).length : documents[id].length;
+}
+
+uint32_t DocumentTable::size() const {
+    return file.isOpen() ? mappedCount : static_cast<uint32_t>(documents.size());
+}
+
+uint32_t DocumentTable::indexedCount() const {
+    if (file.isOpen()) {
+        return mappedIndexedCount;
+    }
+    uint32_t count = 0;
+    for (const DocumentInfo& document : documents) {
+        count += document.indexed ? 1 : 0;
+    }
+    return count;
+}
+
+double DocumentTable::averageLength() const {
+    // Failed documents have length 0, they would only pull the average down
+    uint32_t count = indexedCount();
+    return count == 0 ? 0.0 : static_cast<double>(lengthSum()) / count;
+}
+
+bool DocumentTable::saveToFile(const std::string& fileName, uint64_t buildId) const {
+    std::ofstream outFile(fileName, std::ios::binary | std::ios::trunc);
+
+    if (!outFile.is_open()) {
+        std::cerr << "Error opening file for writing: " << fileName << std::endl;
+        return false;
+    }
+
+    uint32_t count = size();
+    DocumentTableHeader header{};
+    std::memcpy(header.magic, documentTableMagic, sizeof(header.magic));
+    header.version = documentTableVersion;
+    header.count = count;
+    header.totalLength = lengthSum();
+    header.indexedCount = indexedCount();
+    header.buildId = buildId;
+    header.recordsOffset = sizeof(DocumentTableHeader);
+    header.stringsOffset = header.recordsOffset + static_cast<uint64_t>(count) * sizeof(DocumentRecord);
+
+    // All records come first, so compute the string offsets before writing anything
+    std::vector<DocumentRecord> entries;
+    entries.reserve(count);
+    uint64_t stringsSize = 0;
+    for (uint32_t id = 0; id < count; ++id) {
+        DocumentInfo document = get(id);
+        DocumentRecord entry{stringsSize, static_cast<uint32_t>(document.path.size()),
+                             static_cast<uint32_t>(document.title.size()),
+                             static_cast<uint32_t>(document.url.size()), document.length};
+        stringsSize += document.path.size() + document.title.size() + document.url.size();
+        entries.push_back(entry);
+    }
+    header.fileSize = header.stringsOffset + stringsSize;
+
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(DocumentRecord));
+    for (uint32_t id = 0; id < count; ++id) {
+        DocumentInfo document = get(id);
+        outFile << document.path << document.title << document.url;
+    }
+    outFile.close(); // a full disk may only show when the last buffer is flushed
+
+    if (!outFile) {
+        std::cerr << "Error writing document table: " << fileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool DocumentTable::loadFromFile(const std::string& fileName) {
+    clear();
+
+    if (!file.open(fileName)) {
+        return false;
+    }
+
+    DocumentTableHeader header{};
+    if (file.size() >= sizeof(header)) {
+        std::memcpy(&header, file.data(), sizeof(header));
+    }
+    if (std::memcmp(header.magic, documentTableMagic, sizeof(header.magic)) != 0 ||
+        header.version != documentTableVersion || header.fileSize != file.size()) {
+        std::cerr << "Not a supported document table: " << fileName << std::endl;
+        clear();
+        return false;
+    }
+    // The records and the strings must lie within the file, in that order
+    uint64_t recordsSize = static_cast<uint64_t>(header.count) * sizeof(DocumentRecord);
+    if (header.recordsOffset < sizeof(header) || header.stringsOffset > header.fileSize ||
+        header.recordsOffset > header.stringsOffset ||
+        recordsSize > header.stringsOffset - header.recordsOffset) {
+        std::cerr << "Corrupt document table: " << fileName << std::endl;
+        clear();
+        return false;
+    }
+
+    // Only the header is read now, records are decoded on demand
+    records = file.data() + header.recordsOffset;
+    strings = file.data() + header.stringsOffset;
+    stringsSize = header.fileSize - header.stringsOffset;
+    mappedCount = header.count;
+    totalLength = header.totalLength;
+    mappedIndexedCount = static_cast<uint32_t>(header.indexedCount);
+    mappedBuildId = header.buildId;
+    return true;
+}
+
+void DocumentTable::clear() {
+    documents.clear();
+    totalLength = 0;
+    mappedIndexedCount = 0;
+    mappedBuildId = 0;
+    file.close();
+    records = nullptr;
+    strings = nullptr;
+    stringsSize = 0;
+    mappedCount = 0;
+}
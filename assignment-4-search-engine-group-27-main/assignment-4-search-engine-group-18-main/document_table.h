@@ -0,0 +1,96 @@
+#ifndef DOCUMENT_TABLE_H
+#define DOCUMENT_TABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include "mapped_file.h"
+
+// Metadata that is only needed when printing results, plus the length used for ranking
+struct DocumentInfo {
+    std::string path;
+    std::string title;
+    std::string url;
+    uint32_t length = 0; // number of indexed terms in the article text
+    bool indexed = false; // while building: false until the article was parsed
+};
+
+// Binary document table layout (host byte order):
+//
+//   DocumentTableHeader
+//   records  count DocumentRecord entries, indexed by document ID
+//   strings  path, title and URL of every document, back to back
+struct DocumentTableHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t totalLength;
+    uint64_t recordsOffset;
+    uint64_t stringsOffset;
+    uint64_t fileSize;
+    uint64_t indexedCount; // documents that made it into the index, the N of BM25
+    uint64_t buildId;      // also in the header of every index file written with the table
+};
+
+struct DocumentRecord {
+    uint64_t stringsOffset; // relative to DocumentTableHeader::stringsOffset
+    uint32_t pathLength;
+    uint32_t titleLength;
+    uint32_t urlLength;
+    uint32_t length;
+};
+
+// Maps dense 32-bit document IDs to the article they were assigned to.
+// Postings in the indices only store the ID and a term frequency; everything else lives here.
+// A table built by the indexer lives in memory; a table loaded from disk stays
+// memory-mapped and only decodes the records that are asked for.
+class DocumentTable {
+private:
+    // A deque never moves its elements, so documents can be added while other
+    // threads fill in earlier ones; the lock only guards finding an element
+    std::deque<DocumentInfo> documents;
+    mutable std::shared_mutex growing;
+    uint64_t totalLength = 0; // only kept for a loaded table, summed on demand while building
+    uint32_t mappedIndexedCount = 0;
+    uint64_t mappedBuildId = 0;
+
+    MappedFile file;
+    const char* records = nullptr;
+    const char* strings = nullptr;
+    uint64_t stringsSize = 0;
+    uint32_t mappedCount = 0;
+
+    DocumentRecord record(uint32_t id) const;
+    uint64_t lengthSum() const;
+    DocumentInfo& building(uint32_t id);
+    const DocumentInfo& building(uint32_t id) const;
+
+public:
+    uint32_t addDocument(const std::string& path); // returns the new document ID
+    // Different threads may fill in different documents at the same time,
+    // also while one thread adds documents.
+    // Setting the metadata marks the document as indexed.
+    void setMetadata(uint32_t id, std::string_view title, std::string_view url);
+    void setLength(uint32_t id, uint32_t length);
+    const std::string& getPath(uint32_t id) const { return building(id).path; } // while building
+
+    // A record that points outside a loaded table comes back empty
+    DocumentInfo get(uint32_t id) const;
+    uint32_t getLength(uint32_t id) const;
+    // Over the indexed documents only
+    double averageLength() const;
+    // Every document ID handed out, including articles that failed to read or parse
+    uint32_t size() const;
+    // Documents that made it into the index
+    uint32_t indexedCount() const;
+
+    // buildId ties the table to the index files it was written with
+    bool saveToFile(const std::string& fileName, uint64_t buildId = 0) const;
+    bool loadFromFile(const std::string& fileName);
+    uint64_t buildId() const { return mappedBuildId; } // of a loaded table
+    void clear();
+};
+
+#endif // DOCUMENT_TABLE_H
@@ -12,6 +12,11 @@
 
 #include "stemming.h"
 
+// Spells a literal in the stemmer's character type, so english_stem works on
+// std::string as well as on std::wstring
+#define ENGLISH_STEM_LITERAL(text) \
+    stemming::literal<typename string_typeT::value_type>(text, L##text)
+
 namespace stemming
     {
     /**
@@ -208,8 +213,8 @@ namespace stemming
             if (is_exception(text) )
                 { return; }
 
-            stem<string_typeT>::hash_y(text, L"aeiouyAEIOUY");
-            m_first_vowel = text.find_first_of(L"aeiouyAEIOUY");
+            stem<string_typeT>::hash_y(text, ENGLISH_STEM_LITERAL("aeiouyAEIOUY"));
+            m_first_vowel = text.find_first_of(ENGLISH_STEM_LITERAL("aeiouyAEIOUY"));
             if (m_first_vowel == string_typeT::npos)
                 { return; }
 
@@ -262,10 +267,10 @@ namespace stemming
                 }
             else
                 {
-                stem<string_typeT>::find_r1(text, L"aeiouyAEIOUY");
+                stem<string_typeT>::find_r1(text, ENGLISH_STEM_LITERAL("aeiouyAEIOUY"));
                 }
 
-            stem<string_typeT>::find_r2(text, L"aeiouyAEIOUY");
+            stem<string_typeT>::find_r2(text, ENGLISH_STEM_LITERAL("aeiouyAEIOUY"));
 
             // step 1a:
             step_1a(text);
@@ -307,7 +312,7 @@ namespace stemming
                 stem<string_typeT>::is_either(text[3],
                     common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) )
                 {
-                text = L"ski";
+                text = ENGLISH_STEM_LITERAL("ski");
                 return true;
                 }
             /*skies*/
@@ -323,7 +328,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[4],
                         common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) )
                 {
-                text = L"sky";
+                text = ENGLISH_STEM_LITERAL("sky");
                 return true;
                 }
             /*dying*/
@@ -339,7 +344,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[4],
                         common_lang_constants::LOWER_G, common_lang_constants::UPPER_G) )
                 {
-                text = L"die";
+                text = ENGLISH_STEM_LITERAL("die");
                 return true;
                 }
             /*lying*/
@@ -355,7 +360,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[4],
                        common_lang_constants::LOWER_G, common_lang_constants::UPPER_G) )
                 {
-                text = L"lie";
+                text = ENGLISH_STEM_LITERAL("lie");
                 return true;
                 }
             /*tying*/
@@ -371,7 +376,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[4],
                         common_lang_constants::LOWER_G, common_lang_constants::UPPER_G) )
                 {
-                text = L"tie";
+                text = ENGLISH_STEM_LITERAL("tie");
                 return true;
                 }
             /*idly*/
@@ -385,7 +390,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[3],
                         common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
                 {
-                text = L"idl";
+                text = ENGLISH_STEM_LITERAL("idl");
                 return true;
                 }
             /*gently*/
@@ -403,7 +408,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[5],
                         common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
                 {
-                text = L"gentl";
+                text = ENGLISH_STEM_LITERAL("gentl");
                 return true;
                 }
             /*ugly*/
@@ -417,7 +422,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[3],
                         common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
                 {
-                text = L"ugli";
+                text = ENGLISH_STEM_LITERAL("ugli");
                 return true;
                 }
             /*early*/
@@ -433,7 +438,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[4],
                         common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
                 {
-                text = L"earli";
+                text = ENGLISH_STEM_LITERAL("earli");
                 return true;
                 }
             /*only*/
@@ -447,7 +452,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[3],
                         common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
                 {
-                text = L"onli";
+                text = ENGLISH_STEM_LITERAL("onli");
                 return true;
                 }
             /*singly*/
@@ -465,7 +470,7 @@ namespace stemming
                     stem<string_typeT>::is_either(text[5],
                         common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
                 {
-                text = L"singl";
+                text = ENGLISH_STEM_LITERAL("singl");
                 return true;
                 }
             // exception #1
@@ -686,177 +691,125 @@ namespace stemming
         //---------------------------------------------
         void step_1a(string_typeT& text)
             {
-            if (stem<string_typeT>::is_suffix(text,
-                /*sses*/
-                common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) )
-                {
-                text.erase(text.length()-2);
-                stem<string_typeT>::update_r_sections(text);
-                }
-            else if (stem<string_typeT>::is_suffix(text,
-                        /*ied*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                        common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ies*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                        common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) )
+            if (text.empty())
+                { return; }
+            switch (fold_case(text[text.length()-1]))
                 {
-                if (text.length() == 3 || text.length() == 4)
+            case 's':
+                if (has_suffix(text, "sses"))
                     {
-                    text.erase(text.length()-1);
+                    text.erase(text.length()-2);
                     stem<string_typeT>::update_r_sections(text);
                     }
-                else
+                else if (has_suffix(text, "ies"))
+                    { trim_ied_ies(text); }
+                else if (text.length() >= 2 &&
+                    m_first_vowel < text.length()-2 &&
+                    !stem<string_typeT>::is_one_of(text[text.length()-2], ENGLISH_STEM_LITERAL("suSU")) )
                     {
-                    text.erase(text.length()-2);
+                    text.erase(text.length()-1);
                     stem<string_typeT>::update_r_sections(text);
                     }
+                break;
+            case 'd':
+                if (has_suffix(text, "ied"))
+                    { trim_ied_ies(text); }
+                break;
+            default:
+                break;
                 }
-            else if (text.length() >= 2 &&
-                    stem<string_typeT>::is_either(text[text.length()-1],
-                        common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) &&
-                    m_first_vowel < text.length()-2 &&
-                    !stem<string_typeT>::is_one_of(text[text.length()-2], L"suSU") )
+            }
+        //---------------------------------------------
+        void trim_ied_ies(string_typeT& text)
+            {
+            if (text.length() == 3 || text.length() == 4)
                 {
                 text.erase(text.length()-1);
                 stem<string_typeT>::update_r_sections(text);
                 }
+            else
+                {
+                text.erase(text.length()-2);
+                stem<string_typeT>::update_r_sections(text);
+                }
             }
         //---------------------------------------------
         void step_1b(string_typeT& text)
             {
+            if (text.empty())
+                { return; }
             // if the preceding word contains a vowel
             bool regress_trim = false;
 
-            if (stem<string_typeT>::is_suffix(text,
-                /*eed*/
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) )
+            switch (fold_case(text[text.length()-1]))
                 {
-                if (stem<string_typeT>::get_r1() <= text.length()-3)
+            case 'd':
+                if (has_suffix(text, "eed"))
                     {
-                    text.erase(text.length()-1);
+                    if (stem<string_typeT>::get_r1() <= text.length()-3)
+                        {
+                        text.erase(text.length()-1);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                else if (has_suffix(text, "ed") &&
+                    m_first_vowel < text.length()-2)
+                    {
+                    text.erase(text.length()-2);
                     stem<string_typeT>::update_r_sections(text);
+                    regress_trim = true;
                     }
-                }
-            else if (stem<string_typeT>::is_suffix(text,
-                /*eedly*/
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_D, common_lang_constants::UPPER_D,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-5)
+                break;
+            case 'y':
+                if (has_suffix(text, "eedly"))
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-3);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                else if (has_suffix(text, "edly") &&
+                    m_first_vowel < text.length()-4)
+                    {
+                    text.erase(text.length()-4);
+                    stem<string_typeT>::update_r_sections(text);
+                    regress_trim = true;
+                    }
+                else if (has_suffix(text, "ingly") &&
+                    m_first_vowel < text.length()-5)
+                    {
+                    text.erase(text.length()-5);
+                    stem<string_typeT>::update_r_sections(text);
+                    regress_trim = true;
+                    }
+                break;
+            case 'g':
+                if (has_suffix(text, "ing") &&
+                    m_first_vowel < text.length()-3)
                     {
                     text.erase(text.length()-3);
                     stem<string_typeT>::update_r_sections(text);
+                    regress_trim = true;
                     }
-                }
-            else if (stem<string_typeT>::is_suffix(text,
-                /*ed*/
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) &&
-                m_first_vowel < text.length()-2)
-                {
-                text.erase(text.length()-2);
-                stem<string_typeT>::update_r_sections(text);
-                regress_trim = true;
-                }
-            else if (stem<string_typeT>::is_suffix(text,
-                /*edly*/
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_D, common_lang_constants::UPPER_D,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) &&
-                m_first_vowel < text.length()-4)
-                {
-                text.erase(text.length()-4);
-                stem<string_typeT>::update_r_sections(text);
-                regress_trim = true;
-                }
-            else if (stem<string_typeT>::is_suffix(text,
-                /*ing*/
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                common_lang_constants::LOWER_G, common_lang_constants::UPPER_G) &&
-                m_first_vowel < text.length()-3)
-                {
-                text.erase(text.length()-3);
-                stem<string_typeT>::update_r_sections(text);
-                regress_trim = true;
-                }
-            else if (stem<string_typeT>::is_suffix(text,
-                /*ingly*/
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                common_lang_constants::LOWER_G, common_lang_constants::UPPER_G,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                common_lang_constants::LOWER_Y, common_lang_constants::UPPER_Y) &&
-                m_first_vowel < text.length()-5)
-                {
-                text.erase(text.length()-5);
-                stem<string_typeT>::update_r_sections(text);
-                regress_trim = true;
+                break;
+            default:
+                break;
                 }
             if (regress_trim)
                 {
-                if (stem<string_typeT>::is_suffix(text,
-                        /*at*/common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*bl*/common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                        common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*iz*/common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_Z, common_lang_constants::UPPER_Z) )
+                if (has_suffix(text, "at") ||
+                    has_suffix(text, "bl") ||
+                    has_suffix(text, "iz") )
                     {
                     text += common_lang_constants::LOWER_E;
                     // need to search for r2 again because the 'e' added here may change that
-                    stem<string_typeT>::find_r2(text, L"aeiouyAEIOUY");
+                    stem<string_typeT>::find_r2(text, ENGLISH_STEM_LITERAL("aeiouyAEIOUY"));
                     }
-                else if (stem<string_typeT>::is_suffix(text,
-                            /*bb*/
-                            common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                            common_lang_constants::LOWER_B, common_lang_constants::UPPER_B) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*dd*/
-                            common_lang_constants::LOWER_D, common_lang_constants::UPPER_D,
-                            common_lang_constants::LOWER_D, common_lang_constants::UPPER_D) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*ff*/
-                            common_lang_constants::LOWER_F, common_lang_constants::UPPER_F,
-                            common_lang_constants::LOWER_F, common_lang_constants::UPPER_F) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*gg*/
-                            common_lang_constants::LOWER_G, common_lang_constants::UPPER_G,
-                            common_lang_constants::LOWER_G, common_lang_constants::UPPER_G) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*mm*/common_lang_constants::LOWER_M, common_lang_constants::UPPER_M,
-                            common_lang_constants::LOWER_M, common_lang_constants::UPPER_M) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*nn*/
-                            common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                            common_lang_constants::LOWER_N, common_lang_constants::UPPER_N) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*pp*/
-                            common_lang_constants::LOWER_P, common_lang_constants::UPPER_P,
-                            common_lang_constants::LOWER_P, common_lang_constants::UPPER_P) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*rr*/
-                            common_lang_constants::LOWER_R, common_lang_constants::UPPER_R,
-                            common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) ||
-                        stem<string_typeT>::is_suffix(text,
-                            /*tt*/
-                            common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                            common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) )
+                /*bb dd ff gg mm nn pp rr tt*/
+                else if (text.length() >= 2 &&
+                    fold_case(text[text.length()-1]) == fold_case(text[text.length()-2]) &&
+                    stem<string_typeT>::is_one_of(fold_case(text[text.length()-1]), ENGLISH_STEM_LITERAL("bdfgmnprt")) )
                     {
                     text.erase(text.length()-1);
                     stem<string_typeT>::update_r_sections(text);
@@ -865,7 +818,7 @@ namespace stemming
                     {
                     text += common_lang_constants::LOWER_E;
                     // need to search for r2 again because the 'e' added here may change that
-                    stem<string_typeT>::find_r2(text, L"aeiouyAEIOUY");
+                    stem<string_typeT>::find_r2(text, ENGLISH_STEM_LITERAL("aeiouyAEIOUY"));
                     }
                 }
             }
@@ -891,558 +844,370 @@ namespace stemming
         //---------------------------------------------
         void step_2(string_typeT& text)
             {
-            if (text.length() >= 7 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*ization*/
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_Z, common_lang_constants::UPPER_Z,
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*ational*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ) )
+            if (text.length() < 2)
+                { return; }
+            switch (fold_case(text[text.length()-1]))
                 {
-                if (stem<string_typeT>::get_r1() <= text.length()-7)
+            case 'n':
+                if (has_suffix(text, "ization"))
                     {
-                    text.erase(text.length()-4);
-                    text[static_cast<int>(text.length()-1)] = common_lang_constants::LOWER_E;
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-7)
+                        {
+                        text.erase(text.length()-4);
+                        text[static_cast<int>(text.length()-1)] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 7 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*fulness*/
-                    common_lang_constants::LOWER_F, common_lang_constants::UPPER_F,
-                    common_lang_constants::LOWER_U, common_lang_constants::UPPER_U,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*ousness*/
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_U, common_lang_constants::UPPER_U,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*iveness*/
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_V, common_lang_constants::UPPER_V,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) ) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-7)
+                else if (has_suffix(text, "ation"))
                     {
-                    text.erase(text.length()-4);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-2);
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 6 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*tional*/
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*lessli*/
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-6)
+                break;
+            case 'l':
+                if (has_suffix(text, "ational"))
                     {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-7)
+                        {
+                        text.erase(text.length()-4);
+                        text[static_cast<int>(text.length()-1)] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 6 &&
-                stem<string_typeT>::is_suffix(text,
-                    /*biliti*/
-                    common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-6)
+                else if (has_suffix(text, "tional"))
                     {
-                    text.erase(text.length()-3);
-                    text[text.length()-2] = common_lang_constants::LOWER_L;
-                    text[text.length()-1] = common_lang_constants::LOWER_E;
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-6)
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 5 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*iviti*/
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_V, common_lang_constants::UPPER_V,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*ation*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N) ) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-5)
+                break;
+            case 's':
+                if (has_suffix(text, "fulness") ||
+                    has_suffix(text, "ousness") ||
+                    has_suffix(text, "iveness") )
                     {
-                    text.erase(text.length()-2);
-                    text[text.length()-1] = common_lang_constants::LOWER_E;
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-7)
+                        {
+                        text.erase(text.length()-4);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 5 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*alism*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_M, common_lang_constants::UPPER_M) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*aliti*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-5)
+                break;
+            case 'm':
+                if (has_suffix(text, "alism"))
                     {
-                    text.erase(text.length()-3);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-3);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 5 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*ousli*/
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_U, common_lang_constants::UPPER_U,
-                    common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*entli*/
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*fulli*/
-                    common_lang_constants::LOWER_F, common_lang_constants::UPPER_F,
-                    common_lang_constants::LOWER_U, common_lang_constants::UPPER_U,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-5)
+                break;
+            case 'r':
+                if (has_suffix(text, "izer"))
                     {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text.erase(text.length()-1);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 4 && stem<string_typeT>::is_suffix(text,
-                /*alli*/
-                common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-4)
+                else if (has_suffix(text, "ator"))
                     {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text.erase(text.length()-1);
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
+                break;
+            case 'i':
+                step_2_i(text);
+                break;
+            default:
+                break;
                 }
-            else if (text.length() >= 4 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*enci*/
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*anci*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*abli*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ) )
+            }
+        /// Step 2 suffixes ending in 'i', dispatched on the letter in front of it.
+        //---------------------------------------------
+        void step_2_i(string_typeT& text)
+            {
+            switch (fold_case(text[text.length()-2]))
                 {
-                if (stem<string_typeT>::get_r1() <= text.length()-4)
+            case 't':
+                if (has_suffix(text, "biliti"))
                     {
-                    text[text.length()-1] = common_lang_constants::LOWER_E;
+                    if (stem<string_typeT>::get_r1() <= text.length()-6)
+                        {
+                        text.erase(text.length()-3);
+                        text[text.length()-2] = common_lang_constants::LOWER_L;
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 4 && stem<string_typeT>::is_suffix(text,
-                /*izer*/
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_Z, common_lang_constants::UPPER_Z,
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-4)
+                else if (has_suffix(text, "iviti"))
                     {
-                    text.erase(text.length()-1);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-2);
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 4 &&
-                stem<string_typeT>::is_suffix(text,
-                    /*ator*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-4)
+                else if (has_suffix(text, "aliti"))
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-3);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                break;
+            case 'l':
+                if (has_suffix(text, "lessli"))
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-6)
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                else if (has_suffix(text, "ousli") ||
+                    has_suffix(text, "entli") ||
+                    has_suffix(text, "fulli") )
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                else if (has_suffix(text, "alli"))
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                else if (has_suffix(text, "abli"))
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        }
+                    }
+                else if (text.length() >= 3 &&
+                    stem<string_typeT>::get_r1() <= (text.length()-3) &&
+                    has_suffix(text, "bli"))
                     {
-                    text.erase(text.length()-1);
                     text[text.length()-1] = common_lang_constants::LOWER_E;
-                    stem<string_typeT>::update_r_sections(text);
                     }
-                }
-            else if (text.length() >= 3 &&
-                stem<string_typeT>::get_r1() <= (text.length()-3) &&
-                stem<string_typeT>::is_suffix(text,
-                    /*bli*/
-                    common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) )
-                {
-                text[text.length()-1] = common_lang_constants::LOWER_E;
-                }
-            else if (text.length() >= 3 &&
-                stem<string_typeT>::get_r1() <= (text.length()-3) &&
-                stem<string_typeT>::is_suffix(text,
-                    /*ogi*/
-                    common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                    common_lang_constants::LOWER_G, common_lang_constants::UPPER_G,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) )
-                {
-                if (stem<string_typeT>::is_either(text[text.length()-4],
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
+                else if (stem<string_typeT>::get_r1() <= (text.length()-2))
                     {
-                    text.erase(text.length()-1);
-                    stem<string_typeT>::update_r_sections(text);
+                    /*li*/
+                    if (stem<string_typeT>::is_one_of(text[text.length()-3], ENGLISH_STEM_LITERAL("cdeghkmnrtCDEGHKMNRT")) )
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 2 &&
-                    stem<string_typeT>::get_r1() <= (text.length()-2) &&
-                    stem<string_typeT>::is_suffix(text,
-                        /*li*/
-                        common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) )
-                {
-                if (stem<string_typeT>::is_one_of(text[text.length()-3], L"cdeghkmnrtCDEGHKMNRT") )
+                break;
+            case 'c':
+                if (has_suffix(text, "enci") ||
+                    has_suffix(text, "anci") )
                     {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        }
                     }
+                break;
+            case 'g':
+                if (text.length() >= 3 &&
+                    stem<string_typeT>::get_r1() <= (text.length()-3) &&
+                    has_suffix(text, "ogi"))
+                    {
+                    if (stem<string_typeT>::is_either(text[text.length()-4],
+                        common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
+                        {
+                        text.erase(text.length()-1);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                break;
+            default:
+                break;
                 }
             }
         //---------------------------------------------
         void step_3(string_typeT& text)
             {
-            if (text.length() >= 7 && stem<string_typeT>::is_suffix(text,
-                /*ational*/
-                common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
+            if (text.empty())
+                { return; }
+            switch (fold_case(text[text.length()-1]))
                 {
-                if (stem<string_typeT>::get_r1() <= text.length()-7)
+            case 'l':
+                if (has_suffix(text, "ational"))
                     {
-                    text.erase(text.length()-4);
-                    text[text.length()-1] = common_lang_constants::LOWER_E;
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-7)
+                        {
+                        text.erase(text.length()-4);
+                        text[text.length()-1] = common_lang_constants::LOWER_E;
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 6 && stem<string_typeT>::is_suffix(text,
-                /*tional*/
-                common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-6)
+                else if (has_suffix(text, "tional"))
                     {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-6)
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 5 &&
-                (stem<string_typeT>::is_suffix(text,
-                    /*icate*/
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*iciti*/
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                stem<string_typeT>::is_suffix(text,
-                    /*alize*/
-                    common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                    common_lang_constants::LOWER_Z, common_lang_constants::UPPER_Z,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-5)
+                else if (has_suffix(text, "ical"))
                     {
-                    text.erase(text.length()-3);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text.erase(text.length()-2);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 5 && stem<string_typeT>::is_suffix(text,
-                /*ative*/
-                common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_V, common_lang_constants::UPPER_V,
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) )
-                {
-                if (stem<string_typeT>::get_r2() <= text.length()-5)
+                else if (has_suffix(text, "ful"))
                     {
-                    text.erase(text.length()-5);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-3)
+                        {
+                        text.erase(text.length()-3);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 4 && stem<string_typeT>::is_suffix(text,
-                /*ical*/
-                common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-4)
+                break;
+            case 'e':
+                if (has_suffix(text, "icate") ||
+                    has_suffix(text, "alize") )
                     {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-3);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 4 && stem<string_typeT>::is_suffix(text,
-                /*ness*/
-                common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-4)
+                else if (has_suffix(text, "ative"))
                     {
-                    text.erase(text.length()-4);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r2() <= text.length()-5)
+                        {
+                        text.erase(text.length()-5);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
-                }
-            else if (text.length() >= 3 && stem<string_typeT>::is_suffix(text,
-                /*ful*/
-                common_lang_constants::LOWER_F, common_lang_constants::UPPER_F,
-                common_lang_constants::LOWER_U, common_lang_constants::UPPER_U,
-                common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
-                {
-                if (stem<string_typeT>::get_r1() <= text.length()-3)
+                break;
+            case 'i':
+                if (has_suffix(text, "iciti"))
                     {
-                    text.erase(text.length()-3);
-                    stem<string_typeT>::update_r_sections(text);
+                    if (stem<string_typeT>::get_r1() <= text.length()-5)
+                        {
+                        text.erase(text.length()-3);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
                     }
+                break;
+            case 's':
+                if (has_suffix(text, "ness"))
+                    {
+                    if (stem<string_typeT>::get_r1() <= text.length()-4)
+                        {
+                        text.erase(text.length()-4);
+                        stem<string_typeT>::update_r_sections(text);
+                        }
+                    }
+                break;
+            default:
+                break;
                 }
             }
         //---------------------------------------------
         void step_4(string_typeT& text)
             {
-            if (text.length() >= 5 &&
-                stem<string_typeT>::is_suffix(text,
-                    /*ement*/
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_M, common_lang_constants::UPPER_M,
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                    common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                    common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) )
-                {
-                if (stem<string_typeT>::get_r2() <= text.length()-5)
-                    {
-                    text.erase(text.length()-5);
-                    stem<string_typeT>::update_r_sections(text);
-                    }
-                }
-            else if (text.length() >= 4 &&
-                    (stem<string_typeT>::is_suffix(text,
-                        /*able*/
-                        common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                        common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                        common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ible*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_B, common_lang_constants::UPPER_B,
-                        common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ment*/
-                        common_lang_constants::LOWER_M, common_lang_constants::UPPER_M,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ence*/
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                        common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ance*/
-                        common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                        common_lang_constants::LOWER_C, common_lang_constants::UPPER_C,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E)) )
-                {
-                if (stem<string_typeT>::get_r2() <= text.length()-4)
-                    {
-                    text.erase(text.length()-4);
-                    stem<string_typeT>::update_r_sections(text);
-                    }
-                }
-            else if (text.length() >= 4 &&
-                    (stem<string_typeT>::is_suffix(text,
-                        /*sion*/
-                        common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*tion*/
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N)) )
-                {
-                if (stem<string_typeT>::get_r2() <= text.length()-3)
-                    {
-                    text.erase(text.length()-3);
-                    stem<string_typeT>::update_r_sections(text);
-                    }
-                }
-            else if (text.length() >= 3 &&
-                    (stem<string_typeT>::is_suffix(text,
-                        /*ant*/
-                        common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ent*/
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                        common_lang_constants::LOWER_N, common_lang_constants::UPPER_N,
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ism*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_S, common_lang_constants::UPPER_S,
-                        common_lang_constants::LOWER_M, common_lang_constants::UPPER_M) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ate*/
-                        common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*iti*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_T, common_lang_constants::UPPER_T,
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ous*/
-                        common_lang_constants::LOWER_O, common_lang_constants::UPPER_O,
-                        common_lang_constants::LOWER_U, common_lang_constants::UPPER_U,
-                        common_lang_constants::LOWER_S, common_lang_constants::UPPER_S) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ive*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_V, common_lang_constants::UPPER_V,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ize*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_Z, common_lang_constants::UPPER_Z,
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E)) )
+            if (text.empty())
+                { return; }
+            size_t suffix_length = 0;
+            switch (fold_case(text[text.length()-1]))
                 {
-                if (stem<string_typeT>::get_r2() <= text.length()-3)
-                    {
-                    text.erase(text.length()-3);
-                    stem<string_typeT>::update_r_sections(text);
-                    }
+            case 't':
+                if (has_suffix(text, "ement"))
+                    { suffix_length = 5; }
+                else if (has_suffix(text, "ment"))
+                    { suffix_length = 4; }
+                else if (has_suffix(text, "ant") ||
+                    has_suffix(text, "ent") )
+                    { suffix_length = 3; }
+                break;
+            case 'e':
+                if (has_suffix(text, "able") ||
+                    has_suffix(text, "ible") ||
+                    has_suffix(text, "ence") ||
+                    has_suffix(text, "ance") )
+                    { suffix_length = 4; }
+                else if (has_suffix(text, "ate") ||
+                    has_suffix(text, "ive") ||
+                    has_suffix(text, "ize") )
+                    { suffix_length = 3; }
+                break;
+            case 'n':
+                if (has_suffix(text, "sion") ||
+                    has_suffix(text, "tion") )
+                    { suffix_length = 3; }
+                break;
+            case 'm':
+                if (has_suffix(text, "ism"))
+                    { suffix_length = 3; }
+                break;
+            case 'i':
+                if (has_suffix(text, "iti"))
+                    { suffix_length = 3; }
+                break;
+            case 's':
+                if (has_suffix(text, "ous"))
+                    { suffix_length = 3; }
+                break;
+            case 'l':
+                if (has_suffix(text, "al"))
+                    { suffix_length = 2; }
+                break;
+            case 'r':
+                if (has_suffix(text, "er"))
+                    { suffix_length = 2; }
+                break;
+            case 'c':
+                if (has_suffix(text, "ic"))
+                    { suffix_length = 2; }
+                break;
+            default:
+                break;
                 }
-            else if (text.length() >= 2 &&
-                    (stem<string_typeT>::is_suffix(text,
-                        /*al*/
-                        common_lang_constants::LOWER_A, common_lang_constants::UPPER_A,
-                        common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*er*/
-                        common_lang_constants::LOWER_E, common_lang_constants::UPPER_E,
-                        common_lang_constants::LOWER_R, common_lang_constants::UPPER_R) ||
-                    stem<string_typeT>::is_suffix(text,
-                        /*ic*/
-                        common_lang_constants::LOWER_I, common_lang_constants::UPPER_I,
-                        common_lang_constants::LOWER_C, common_lang_constants::UPPER_C)) )
+            // every step 4 suffix is deleted when it is in R2 ("ion" keeps its s or t)
+            if (suffix_length > 0 &&
+                stem<string_typeT>::get_r2() <= text.length()-suffix_length)
                 {
-                if (stem<string_typeT>::get_r2() <= text.length()-2)
-                    {
-                    text.erase(text.length()-2);
-                    stem<string_typeT>::update_r_sections(text);
-                    }
+                text.erase(text.length()-suffix_length);
+                stem<string_typeT>::update_r_sections(text);
                 }
             }
         //---------------------------------------------
         void step_5(string_typeT& text)
             {
-            if (text.length() >= 1 &&
-                stem<string_typeT>::is_either(text[text.length()-1],
-                    common_lang_constants::LOWER_E, common_lang_constants::UPPER_E) )
+            if (text.empty())
+                { return; }
+            switch (fold_case(text[text.length()-1]))
                 {
+            case 'e':
                 if (stem<string_typeT>::get_r2() != text.length())
                     {
                     text.erase(text.length()-1);
@@ -1457,16 +1222,46 @@ namespace stemming
                     text.erase(text.length()-1);
                     stem<string_typeT>::update_r_sections(text);
                     }
+                break;
+            case 'l':
+                if (stem<string_typeT>::get_r2() != text.length() &&
+                    has_suffix(text, "ll"))
+                    {
+                    text.erase(text.length()-1);
+                    stem<string_typeT>::update_r_sections(text);
+                    }
+                break;
+            default:
+                break;
                 }
-            else if (stem<string_typeT>::get_r2() != text.length() &&
-                stem<string_typeT>::is_suffix(text,
-                    /*ll*/
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L,
-                    common_lang_constants::LOWER_L, common_lang_constants::UPPER_L) )
+            }
+        /// @returns @c character with A-Z folded to lowercase. Everything else, including
+        ///     the hashed Ys, is returned unchanged.
+        [[nodiscard]]
+        constexpr static typename string_typeT::value_type fold_case(
+            const typename string_typeT::value_type character) noexcept
+            {
+            return (character >= 'A' && character <= 'Z') ?
+                static_cast<typename string_typeT::value_type>(character + ('a' - 'A')) :
+                character;
+            }
+        /** @returns @c true if @c text ends with @c suffix, ignoring case.
+            @param suffix The lowercase suffix; its length is known at compile time,
+                so the comparison unrolls into one backward scan.*/
+        template<size_t N>
+        [[nodiscard]]
+        static bool has_suffix(const string_typeT& text, const char (&suffix)[N]) noexcept
+            {
+            constexpr size_t suffix_length = N-1;
+            if (text.length() < suffix_length)
+                { return false; }
+            const size_t start = text.length()-suffix_length;
+            for (size_t i = suffix_length; i-- > 0; )
                 {
-                text.erase(text.length()-1);
-                stem<string_typeT>::update_r_sections(text);
+                if (fold_case(text[start+i]) != static_cast<typename string_typeT::value_type>(suffix[i]))
+                    { return false; }
                 }
+            return true;
             }
         /**Define a short syllable in a word as either
         (a) a vowel followed by a non-vowel other than w, x or Y and preceded by a non-vowel, or 
@@ -1486,14 +1281,14 @@ namespace stemming
                 }
             else if (length > 2)
                 {
-                const size_t start = text.find_last_of(L"aeiouyAEIOUY", length-1);
+                const size_t start = text.find_last_of(ENGLISH_STEM_LITERAL("aeiouyAEIOUY"), length-1);
                 if (start == string_typeT::npos)
                     { return false; }
                 if (start > 0 &&
                     start == (length-2) &&
                     // following letter
                     (!is_vowel(text[start+1]) &&
-                    !stem<string_typeT>::is_one_of(text[start+1], L"wxWX") &&
+                    !stem<string_typeT>::is_one_of(text[start+1], ENGLISH_STEM_LITERAL("wxWX")) &&
                     stem<string_typeT>::is_neither(text[start+1], LOWER_Y_HASH, UPPER_Y_HASH)) &&
                     // proceeding letter
                     !is_vowel(text[start-1]) )
@@ -1513,7 +1308,7 @@ namespace stemming
             }
         //---------------------------------------------
         inline bool is_vowel(const wchar_t character) const noexcept
-            { return (stem<string_typeT>::is_one_of(character, L"aeiouyAEIOUY") ); }
+            { return (stem<string_typeT>::is_one_of(character, ENGLISH_STEM_LITERAL("aeiouyAEIOUY")) ); }
 
         size_t m_first_vowel{ string_typeT::npos };
         };
@@ -1521,4 +1316,6 @@ namespace stemming
 
 /** @}*/
 
+#undef ENGLISH_STEM_LITERAL
+
 #endif // __ENGLISH_STEM_H__
@@ -0,0 +1,118 @@
+#ifndef FIXED_STRING_H
+#define FIXED_STRING_H
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+// Byte string with inline storage for at most Capacity characters. It offers
+// the part of the std::string interface the Snowball stemmers use, so
+// english_stem<FixedString<N>> stems a word on the stack. Stemming only
+// shortens a word or rewrites its suffix, so it never outgrows the input.
+template <size_t Capacity>
+class FixedString {
+private:
+    char characters[Capacity + 1];
+    size_t count;
+
+    static bool contains(const char* list, char ch) {
+        for (; *list != '\0'; ++list) {
+            if (*list == ch)
+                return true;
+        }
+        return false;
+    }
+
+public:
+    using value_type = char;
+    using size_type = size_t;
+    using iterator = char*;
+    using const_iterator = const char*;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    FixedString() : count(0) { characters[0] = '\0'; }
+    // word must not be longer than Capacity
+    explicit FixedString(std::string_view word) : count(word.size()) {
+        std::memcpy(characters, word.data(), count);
+        characters[count] = '\0';
+    }
+
+    FixedString& operator=(const char* text) {
+        count = std::strlen(text);
+        std::memcpy(characters, text, count + 1);
+        return *this;
+    }
+
+    FixedString& operator+=(char ch) {
+        characters[count++] = ch;
+        characters[count] = '\0';
+        return *this;
+    }
+
+    size_t length() const { return count; }
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    const char* data() const { return characters; }
+    std::string_view view() const { return std::string_view(characters, count); }
+
+    char& operator[](size_t i) { return characters[i]; }
+    const char& operator[](size_t i) const { return characters[i]; }
+    char& back() { return characters[count - 1]; }
+    const char& back() const { return characters[count - 1]; }
+
+    char* begin() { return characters; }
+    char* end() { return characters + count; }
+    const char* begin() const { return characters; }
+    const char* end() const { return characters + count; }
+    const char* cbegin() const { return characters; }
+    const char* cend() const { return characters + count; }
+
+    void pop_back() { characters[--count] = '\0'; }
+
+    FixedString& erase(size_t position, size_t length = npos) {
+        if (length == npos || position + length >= count) {
+            count = position;
+        } else {
+            std::memmove(characters + position, characters + position + length, count - position - length);
+            count -= length;
+        }
+        characters[count] = '\0';
+        return *this;
+    }
+
+    size_t find(char ch, size_t position = 0) const {
+        for (size_t i = position; i < count; ++i) {
+            if (characters[i] == ch)
+                return i;
+        }
+        return npos;
+    }
+
+    size_t find_first_of(const char* list, size_t position = 0) const {
+        for (size_t i = position; i < count; ++i) {
+            if (contains(list, characters[i]))
+                return i;
+        }
+        return npos;
+    }
+
+    size_t find_first_not_of(const char* list, size_t position = 0) const {
+        for (size_t i = position; i < count; ++i) {
+            if (!contains(list, characters[i]))
+                return i;
+        }
+        return npos;
+    }
+
+    size_t find_last_of(const char* list, size_t position = npos) const {
+        if (count == 0)
+            return npos;
+        for (size_t i = position < count ? position + 1 : count; i-- > 0;) {
+            if (contains(list, characters[i]))
+                return i;
+        }
+        return npos;
+    }
+};
+
+#endif // FIXED_STRING_H
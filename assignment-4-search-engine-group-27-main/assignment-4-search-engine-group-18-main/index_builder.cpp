@@ -0,0 +1,137 @@
+// index_builder.cpp
+#include "index_builder.h"
+#include "index_file.h"
+#include <algorithm>
+#include <cstdio>
+
+IndexBuilder::IndexBuilder(const std::string& runPrefix, size_t memoryBudget, uint64_t buildId)
+    : runPrefix(runPrefix), memoryBudget(memoryBudget), buildId(buildId), spillFailed(false) {}
+
+PartialIndex::PartialIndex(const std::string& mainPrefix, const std::string& organizationPrefix,
+                           const std::string& personsPrefix, size_t memoryBudget, uint64_t buildId)
+    // The article text dominates, so the main index gets most of the budget
+    : mainIndex(mainPrefix, memoryBudget / 10 * 8, buildId),
+      organizationIndex(organizationPrefix, memoryBudget / 10, buildId),
+      personsIndex(personsPrefix, memoryBudget / 10, buildId) {}
+
+size_t IndexBuilder::memoryUsage() const {
+    // Hash nodes hold the entry plus a next pointer and the cached hash
+    size_t nodeSize = sizeof(decltype(dictionary)::value_type) + 2 * sizeof(void*);
+    return dataArena.bytesAllocated() + dictionary.size() * nodeSize +
+           dictionary.bucket_count() * sizeof(void*);
+}
+
+void IndexBuilder::insertDocument(uint32_t document, const std::vector<std::string_view>& terms) {
+    for (std::string_view term : terms) {
+        auto found = dictionary.find(term);
+        if (found == dictionary.end()) {
+            // The key must outlive the caller's buffer
+            found = dictionary.emplace(dataArena.copyString(term), TermPostings(dataArena)).first;
+        }
+
+        TermPostings& entry = found->second;
+        if (entry.postings.empty() || entry.postings.back().docId != document) {
+            entry.postings.push_back({document, 1});
+        } else {
+            entry.postings.back().frequency++;
+        }
+        entry.frequency++;
+    }
+
+    // Only spilled between documents, so a document never spans two runs
+    if (memoryUsage() >= memoryBudget) {
+        spill();
+    }
+}
+
+bool IndexBuilder::writeRun(const std::string& runFile) {
+    // With work stealing, documents reach a builder out of order
+    for (auto& entry : dictionary) {
+        PostingList& postings = entry.second.postings;
+        auto byDocument = [](const Posting& a, const Posting& b) { return a.docId < b.docId; };
+        if (!std::is_sorted(postings.begin(), postings.end(), byDocument)) {
+            std::sort(postings.begin(), postings.end(), byDocument);
+        }
+    }
+
+    IndexFileWriter writer;
+    if (!writer.open(runFile, buildId)) {
+        return false;
+    }
+
+    // The only sort of the run: by key, so it can be merged and searched
+    std::vector<const std::pair<const std::string_view, TermPostings>*> sorted;
+    sorted.reserve(dictionary.size());
+    for (const auto& entry : dictionary) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const auto* a, const auto* b) {
+        return a->first < b->first;
+    });
+
+    for (const auto* entry : sorted) {
+        const TermPostings& term = entry->second;
+        writer.addTerm(entry->first, term.frequency, term.postings.data(), term.postings.size());
+    }
+    return writer.close();
+}
+
+void IndexBuilder::spill() {
+    if (dictionary.empty())
+        return;
+
+    // After a failed run the index is incomplete anyway: indexing goes on
+    // within the budget, but nothing more is written and releaseRuns reports it
+    std::string runFile = runPrefix + ".run" + std::to_string(runs.size());
+    if (!spillFailed && writeRun(runFile)) {
+        runs.push_back(runFile);
+    } else if (!spillFailed) {
+        std::remove(runFile.c_str());
+        spillFailed = true;
+    }
+
+    // Drop the entries before rewinding the arena that holds their buffers
+    dictionary.clear();
+    dataArena.reset();
+}
+
+bool IndexBuilder::releaseRuns(std::vector<std::string>& result) {
+    spill();
+    if (spillFailed) {
+        discard();
+        spillFailed = false;
+        return false;
+    }
+    result.insert(result.end(), runs.begin(), runs.end());
+    runs.clear();
+    return true;
+}
+
+void IndexBuilder::discard() {
+    dictionary.clear();
+    dataArena.reset();
+    for (const std::string& run : runs) {
+        std::remove(run.c_str());
+    }
+    runs.clear();
+}
+
+bool IndexBuilder::mergeRuns(const std::vector<std::string>& runs, const std::string& fileName) {
+    bool merged;
+    if (runs.size() == 1) {
+        // A single run already is a complete index
+        std::remove(fileName.c_str());
+        merged = std::rename(runs[0].c_str(), fileName.c_str()) == 0;
+    } else {
+        merged = mergeIndexFiles(runs, fileName);
+    }
+    if (!merged) {
+        std::remove(fileName.c_str());
+        return false;
+    }
+
+    for (const std::string& run : runs) {
+        std::remove(run.c_str());
+    }
+    return true;
+}
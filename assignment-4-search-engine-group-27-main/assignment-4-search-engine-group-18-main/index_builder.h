@@ -0,0 +1,74 @@
+#ifndef INDEX_BUILDER_H
+#define INDEX_BUILDER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include "posting.h"
+#include "arena.h"
+
+constexpr size_t defaultIndexMemoryBudget = 64 * 1024 * 1024;
+
+// Single-pass in-memory indexer (SPIMI) for one index file. Postings are
+// appended to a hash dictionary as documents arrive, nothing is kept sorted.
+// Once the dictionary outgrows the memory budget its terms are sorted once,
+// spilled to disk as an immutable run and the memory is reused for the next
+// run. mergeRuns() combines the runs of one or more builders into the final
+// index in one heap-based pass, so peak memory depends on the budget and not
+// on the corpus size. A builder is used by one thread only.
+class IndexBuilder {
+private:
+    struct TermPostings {
+        PostingList postings; // in arrival order, sorted when the run is written
+        uint32_t frequency;   // total occurrences across all documents
+
+        explicit TermPostings(Arena& data) : postings(ArenaAllocator<Posting>(&data)), frequency(0) {}
+    };
+
+    Arena dataArena; // keys and posting buffers of the current run
+    std::unordered_map<std::string_view, TermPostings> dictionary;
+    std::string runPrefix;
+    size_t memoryBudget;
+    uint64_t buildId; // stamped into every run and so into the merged index
+    std::vector<std::string> runs;
+    bool spillFailed; // a run could not be written, the index is incomplete
+
+    size_t memoryUsage() const;
+    bool writeRun(const std::string& runFile);
+    void spill();
+
+public:
+    // Runs are written to runPrefix.run0, runPrefix.run1, ...
+    explicit IndexBuilder(const std::string& runPrefix, size_t memoryBudget = defaultIndexMemoryBudget,
+                          uint64_t buildId = 0);
+    IndexBuilder(const IndexBuilder&) = delete;
+    IndexBuilder& operator=(const IndexBuilder&) = delete;
+
+    // Documents may arrive in any order, but each one only once
+    void insertDocument(uint32_t document, const std::vector<std::string_view>& terms);
+    // Spills what is left in memory and appends all runs to result. False if
+    // any run could not be written; the runs are removed then.
+    bool releaseRuns(std::vector<std::string>& result);
+    // Drops what is in memory and removes the runs written so far
+    void discard();
+    size_t runCount() const { return runs.size(); }
+
+    // Merges runs into fileName and removes them. False if writing failed, the
+    // runs are kept then and no partial fileName is left behind.
+    static bool mergeRuns(const std::vector<std::string>& runs, const std::string& fileName);
+};
+
+// The three indices fed by one indexing thread
+struct PartialIndex {
+    IndexBuilder mainIndex;
+    IndexBuilder organizationIndex;
+    IndexBuilder personsIndex;
+
+    PartialIndex(const std::string& mainPrefix, const std::string& organizationPrefix,
+                 const std::string& personsPrefix, size_t memoryBudget, uint64_t buildId = 0);
+};
+
+#endif // INDEX_BUILDER_H
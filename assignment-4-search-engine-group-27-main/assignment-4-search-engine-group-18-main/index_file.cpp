@@ -0,0 +1,194 @@
+// index_file.cpp
+#include "index_file.h"
+#include "posting_codec.h"
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <utility>
+
+IndexFileWriter::IndexFileWriter() : postingsSize(0), buildId(0) {}
+
+bool IndexFileWriter::open(const std::string& fileName, uint64_t buildId) {
+    this->fileName = fileName;
+    this->buildId = buildId;
+    dictionary.clear();
+    keys.clear();
+    postingsSize = 0;
+
+    out.open(fileName, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        std::cerr << "Error opening file for writing: " << fileName << std::endl;
+        return false;
+    }
+
+    // Placeholder, the real header is written by close() once the offsets are known
+    IndexFileHeader header{};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    return true;
+}
+
+void IndexFileWriter::addTerm(std::string_view key, uint32_t frequency, const Posting* postings, size_t count) {
+    TermEntry entry;
+    entry.postingsOffset = postingsSize;
+    entry.keyOffset = static_cast<uint32_t>(keys.size());
+    entry.keyLength = static_cast<uint32_t>(key.size());
+    entry.postingCount = static_cast<uint32_t>(count);
+    entry.frequency = frequency;
+    dictionary.push_back(entry);
+    keys.append(key);
+
+    encoded.clear();
+    encodePostings(postings, count, encoded);
+    out.write(encoded.data(), encoded.size());
+    postingsSize += encoded.size();
+}
+
+bool IndexFileWriter::close() {
+    IndexFileHeader header{};
+    std::memcpy(header.magic, indexFileMagic, sizeof(header.magic));
+    header.version = indexFileVersion;
+    header.termCount = dictionary.size();
+    header.postingsOffset = sizeof(IndexFileHeader);
+    header.dictionaryOffset = header.postingsOffset + postingsSize;
+    header.keysOffset = header.dictionaryOffset + dictionary.size() * sizeof(TermEntry);
+    header.fileSize = header.keysOffset + keys.size();
+    header.buildId = buildId;
+
+    out.write(reinterpret_cast<const char*>(dictionary.data()), dictionary.size() * sizeof(TermEntry));
+    out.write(keys.data(), keys.size());
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.close();
+
+    if (!out) {
+        std::cerr << "Error writing index file: " << fileName << std::endl;
+        return false;
+    }
+    return true;
+}
+
+IndexFileReader::IndexFileReader() : header{}, postingData(nullptr), dictionaryData(nullptr), keyData(nullptr) {}
+
+bool IndexFileReader::open(const std::string& fileName) {
+    close();
+    if (!file.open(fileName)) {
+        return false;
+    }
+
+    if (file.size() < sizeof(IndexFileHeader)) {
+        std::cerr << "Not a supported index file: " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    std::memcpy(&header, file.data(), sizeof(header));
+    if (std::memcmp(header.magic, indexFileMagic, sizeof(header.magic)) != 0 ||
+        header.version != indexFileVersion || header.fileSize != file.size()) {
+        std::cerr << "Not a supported index file: " << fileName << std::endl;
+        close();
+        return false;
+    }
+
+    postingData = file.data() + header.postingsOffset;
+    dictionaryData = file.data() + header.dictionaryOffset;
+    keyData = file.data() + header.keysOffset;
+    return true;
+}
+
+void IndexFileReader::close() {
+    file.close();
+    header = IndexFileHeader{};
+    postingData = nullptr;
+    dictionaryData = nullptr;
+    keyData = nullptr;
+}
+
+TermEntry IndexFileReader::entry(size_t i) const {
+    TermEntry result;
+    std::memcpy(&result, dictionaryData + i * sizeof(TermEntry), sizeof(TermEntry));
+    return result;
+}
+
+std::string_view IndexFileReader::key(const TermEntry& entry) const {
+    return std::string_view(keyData + entry.keyOffset, entry.keyLength);
+}
+
+void IndexFileReader::readPostings(const TermEntry& entry, Posting* out) const {
+    decodePostings(postingData + entry.postingsOffset, entry.postingCount, out);
+}
+
+bool IndexFileReader::find(std::string_view key, TermEntry& result) const {
+    size_t first = 0;
+    size_t last = termCount();
+    while (first < last) {
+        size_t middle = first + (last - first) / 2;
+        TermEntry candidate = entry(middle);
+        std::string_view candidateKey = this->key(candidate);
+        if (candidateKey < key) {
+            first = middle + 1;
+        } else if (key < candidateKey) {
+            last = middle;
+        } else {
+            result = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool mergeIndexFiles(const std::vector<std::string>& inputs, const std::string& output) {
+    std::vector<IndexFileReader> readers(inputs.size());
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        if (!readers[i].open(inputs[i])) {
+            return false;
+        }
+    }
+
+    IndexFileWriter writer;
+    if (!writer.open(output, readers.empty() ? 0 : readers[0].buildId())) {
+        return false;
+    }
+
+    // Smallest key first; on equal keys the earlier input wins
+    using Cursor = std::pair<std::string_view, size_t>; // key, input
+    std::priority_queue<Cursor, std::vector<Cursor>, std::greater<Cursor>> heap;
+    std::vector<size_t> next(readers.size(), 0);
+    for (size_t i = 0; i < readers.size(); ++i) {
+        if (readers[i].termCount() > 0) {
+            heap.emplace(readers[i].key(readers[i].entry(0)), i);
+        }
+    }
+
+    std::vector<Posting> postings;
+    while (!heap.empty()) {
+        std::string_view key = heap.top().first;
+        uint32_t frequency = 0;
+        postings.clear();
+
+        while (!heap.empty() && heap.top().first == key) {
+            size_t input = heap.top().second;
+            heap.pop();
+
+            TermEntry entry = readers[input].entry(next[input]++);
+            size_t offset = postings.size();
+            postings.resize(offset + entry.postingCount);
+            readers[input].readPostings(entry, postings.data() + offset);
+            frequency += entry.frequency;
+
+            if (next[input] < readers[input].termCount()) {
+                heap.emplace(readers[input].key(readers[input].entry(next[input])), input);
+            }
+        }
+
+        // Inputs written by different threads interleave their document IDs
+        auto byDocument = [](const Posting& a, const Posting& b) { return a.docId < b.docId; };
+        if (!std::is_sorted(postings.begin(), postings.end(), byDocument)) {
+            std::sort(postings.begin(), postings.end(), byDocument);
+        }
+        writer.addTerm(key, frequency, postings.data(), postings.size());
+    }
+
+    return writer.close();
+}
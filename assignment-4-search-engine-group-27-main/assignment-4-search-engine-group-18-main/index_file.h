@@ -0,0 +1,98 @@
+#ifndef INDEX_FILE_H
+#define INDEX_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "posting.h"
+#include "mapped_file.h"
+
+// Binary index file layout (all integers in host byte order):
+//
+//   IndexFileHeader
+//   postings    for every term, its postingCount postings compressed as
+//               described in posting_codec.h
+//   dictionary  termCount TermEntry records sorted by key
+//   keys        the key bytes of all terms, back to back
+//
+// The header stores the offset of each section. Terms are written in sorted
+// order: IndexFileReader maps the file and binary searches the dictionary in
+// place, comparing against the keys section; postings are only decoded for
+// the terms a query finds. (AVLTree::loadFromFile also reads this format.)
+
+struct IndexFileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+    uint64_t termCount;
+    uint64_t postingsOffset;
+    uint64_t dictionaryOffset;
+    uint64_t keysOffset;
+    uint64_t fileSize;
+    uint64_t buildId; // the same in all files of one index, see DocumentTableHeader
+};
+
+struct TermEntry {
+    uint64_t postingsOffset; // byte offset relative to IndexFileHeader::postingsOffset
+    uint32_t keyOffset;      // relative to IndexFileHeader::keysOffset
+    uint32_t keyLength;
+    uint32_t postingCount;
+    uint32_t frequency;      // total occurrences across all documents
+};
+
+constexpr char indexFileMagic[8] = {'S', 'S', 'I', 'N', 'D', 'E', 'X', '\0'};
+constexpr uint32_t indexFileVersion = 3;
+
+// Streams a sorted sequence of terms into an index file
+class IndexFileWriter {
+private:
+    std::ofstream out;
+    std::string fileName;
+    std::vector<TermEntry> dictionary;
+    std::string keys;
+    uint64_t postingsSize;
+    uint64_t buildId;
+    std::string encoded; // reused encoding buffer
+
+public:
+    IndexFileWriter();
+    bool open(const std::string& fileName, uint64_t buildId = 0);
+    // Terms must be added in strictly increasing key order
+    void addTerm(std::string_view key, uint32_t frequency, const Posting* postings, size_t count);
+    bool close();
+};
+
+// Read-only view of a memory-mapped index file. Terms are looked up with a
+// binary search over the on-disk dictionary, nothing is copied up front.
+class IndexFileReader {
+private:
+    MappedFile file;
+    IndexFileHeader header;
+    const char* postingData;
+    const char* dictionaryData;
+    const char* keyData;
+
+public:
+    IndexFileReader();
+    bool open(const std::string& fileName);
+    void close();
+
+    size_t termCount() const { return static_cast<size_t>(header.termCount); }
+    uint64_t buildId() const { return header.buildId; }
+    TermEntry entry(size_t i) const;
+    std::string_view key(const TermEntry& entry) const;
+    // Binary search for key, returns false if the term is not in the file
+    bool find(std::string_view key, TermEntry& result) const;
+    // Decodes the postings of entry into out, which must hold entry.postingCount elements
+    void readPostings(const TermEntry& entry, Posting* out) const;
+};
+
+// Merges sorted index files into one. A document may appear in several inputs,
+// but only in one posting list per term; merged lists are sorted by document ID.
+// The inputs are runs of one build, the output keeps their build ID.
+bool mergeIndexFiles(const std::vector<std::string>& inputs, const std::string& output);
+
+#endif // INDEX_FILE_H
@@ -0,0 +1,199 @@
+// ingest_pipeline.cpp
+#include "ingest_pipeline.h"
+#include "document_parser.h"
+#include "uring_file_reader.h"
+#include "work_stealing_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// What travels between the stages. The file buffer moves along with the
+// parsed article because the fields point into it.
+struct RawArticle {
+    uint32_t docId = 0;
+    std::vector<char> json;
+};
+
+struct ParsedArticle {
+    uint32_t docId = 0;
+    std::vector<char> json;
+    ArticleFields fields;
+};
+
+PipelineOptions PipelineOptions::forThreads(size_t threads) {
+    PipelineOptions options;
+    options.parsers = std::max<size_t>(1, threads / 4);
+    size_t taken = 1 + options.parsers; // the read thread and the parsers
+    options.analyzers = threads > taken ? threads - taken : 1;
+    return options;
+}
+
+IngestPipeline::IngestPipeline(const PipelineOptions& options) : options(options) {}
+
+// Starts count threads running body(thread); the last one to finish calls done
+template <typename Body, typename Done>
+static void startStage(std::vector<std::thread>& threads, size_t count, Body body, Done done) {
+    auto remaining = std::make_shared<std::atomic<size_t>>(count);
+    for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back([i, remaining, body, done] {
+            body(i);
+            if (remaining->fetch_sub(1) == 1) {
+                done();
+            }
+        });
+    }
+}
+
+template <typename ReadStage>
+void IngestPipeline::runStages(DocumentTable& documents, std::vector<std::unique_ptr<PartialIndex>>& partials,
+                               ReadStage read) {
+    BoundedQueue<RawArticle> raw(options.queueDepth);
+    BoundedQueue<ParsedArticle> parsed(options.queueDepth);
+    BoundedQueue<AnalyzedArticle> analyzed(options.queueDepth);
+    // File buffers the analyzers are done with, handed back to the readers.
+    // Once every buffer has grown to the usual article size, reading does not
+    // allocate; a buffer that does not fit is simply freed.
+    BoundedQueue<std::vector<char>> spare(2 * options.queueDepth);
+
+    std::vector<std::thread> threads;
+
+    startStage(threads, std::max<size_t>(1, options.parsers), [&](size_t) {
+        RawArticle article;
+        ParsedArticle result;
+        while (raw.pop(article)) {
+            result.docId = article.docId;
+            result.json = std::move(article.json);
+            if (DocumentParser::parseArticle(result.json, documents.getPath(result.docId), result.fields)) {
+                DocumentParser::loadMetadata(result.fields, result.docId, documents);
+                parsed.push(std::move(result));
+            }
+        }
+    }, [&] { parsed.close(); });
+
+    startStage(threads, std::max<size_t>(1, options.analyzers), [&](size_t) {
+        ParsedArticle article;
+        while (parsed.pop(article)) {
+            AnalyzedArticle terms;
+            DocumentParser::analyzeArticle(article.fields, article.docId, documents, terms);
+            spare.tryPush(article.json);
+            analyzed.push(std::move(terms));
+        }
+    }, [&] { analyzed.close(); });
+
+    startStage(threads, partials.size(), [&](size_t thread) {
+        AnalyzedArticle article;
+        while (analyzed.pop(article)) {
+            DocumentParser::indexArticle(article, *partials[thread]);
+        }
+    }, [] {});
+
+    // The read stage runs on this thread
+    read(raw, spare);
+    raw.close();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    readQueue = raw.metrics();
+    parseQueue = parsed.metrics();
+    analyzeQueue = analyzed.metrics();
+}
+
+void IngestPipeline::run(DocumentTable& documents, std::vector<std::unique_ptr<PartialIndex>>& partials,
+                         const ArticleSource& source) {
+    usedMemory = static_cast<bool>(source);
+    usedUring = false;
+    usedStream = false;
+    size_t count = documents.size();
+
+    // Articles in memory are copied out front to back, files go through one
+    // io_uring that keeps many of them in flight, or otherwise through the
+    // pool's helpers one at a time each
+    runStages(documents, partials, [&](BoundedQueue<RawArticle>& raw, BoundedQueue<std::vector<char>>& spare) {
+        if (usedMemory) {
+            for (size_t index = 0; index < count; ++index) {
+                RawArticle article;
+                article.docId = static_cast<uint32_t>(index);
+                spare.tryPop(article.json);
+                std::string_view contents = source(index);
+                article.json.assign(contents.begin(), contents.end());
+                article.json.push_back('\0'); // the parser works in place on its own copy
+                raw.push(std::move(article));
+            }
+            return;
+        }
+
+        std::vector<bool> delivered(count, false);
+        UringFileReader ring(options.readsInFlight);
+        usedUring = ring.isAvailable() && ring.readFiles(
+            count,
+            [&](size_t index) -> const std::string& { return documents.getPath(static_cast<uint32_t>(index)); },
+            [&](size_t index, std::vector<char>& contents) {
+                delivered[index] = true;
+                raw.push({static_cast<uint32_t>(index), std::move(contents)});
+                spare.tryPop(contents);
+            });
+
+        if (!usedUring) {
+            // Also picks up whatever a failed ring did not deliver
+            WorkStealingPool readers(options.readers);
+            readers.run(count, [&](size_t, size_t index) {
+                if (delivered[index])
+                    return;
+                RawArticle article;
+                article.docId = static_cast<uint32_t>(index);
+                spare.tryPop(article.json);
+                if (DocumentParser::readArticle(documents.getPath(article.docId), article.json)) {
+                    raw.push(std::move(article));
+                }
+            });
+        }
+    });
+}
+
+void IngestPipeline::runStream(DocumentTable& documents, std::vector<std::unique_ptr<PartialIndex>>& partials,
+                               const ArticleStream& stream) {
+    usedMemory = false;
+    usedUring = false;
+    usedStream = true;
+
+    // One run for the whole stream: the table grows while the other stages
+    // fill in the documents already handed to them
+    runStages(documents, partials, [&](BoundedQueue<RawArticle>& raw, BoundedQueue<std::vector<char>>& spare) {
+        RawArticle article;
+        spare.tryPop(article.json);
+        while (stream(article.docId, article.json)) {
+            raw.push(std::move(article));
+            article = RawArticle();
+            spare.tryPop(article.json);
+        }
+    });
+}
+
+static void printQueue(std::ostream& out, const char* name, const QueueMetrics& queue) {
+    out << "  " << name << ": max depth " << queue.maxDepth << "/" << queue.capacity
+        << ", average depth " << queue.averageDepth
+        << ", producers stalled " << queue.producerStallMs << " ms"
+        << ", consumers stalled " << queue.consumerStallMs << " ms\n";
+}
+
+void IngestPipeline::printMetrics(std::ostream& out) const {
+    out << "Pipeline (";
+    if (usedStream) {
+        out << "stream, ";
+    } else if (usedMemory) {
+        out << "articles in memory, ";
+    } else if (usedUring) {
+        out << "io_uring with " << options.readsInFlight << " reads in flight, ";
+    } else {
+        out << options.readers << " readers, ";
+    }
+    out << options.parsers << " parsers, " << options.analyzers << " analyzers):\n";
+    printQueue(out, "read -> parse", readQueue);
+    printQueue(out, "parse -> analyze", parseQueue);
+    printQueue(out, "analyze -> index", analyzeQueue);
+}
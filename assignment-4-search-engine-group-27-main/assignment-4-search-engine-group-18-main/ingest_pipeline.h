@@ -0,0 +1,76 @@
+#ifndef INGEST_PIPELINE_H
+#define INGEST_PIPELINE_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include "bounded_queue.h"
+#include "document_table.h"
+#include "index_builder.h"
+
+// Threads per stage and the depth of the queues between them. There is one
+// index stage thread per PartialIndex, so that count is not set here.
+struct PipelineOptions {
+    size_t readsInFlight = 64; // io_uring reader
+    size_t readers = 2;        // read threads when io_uring is not available
+    size_t parsers = 1;
+    size_t analyzers = 1;
+    size_t queueDepth = 64;
+
+    // Divides threads between the read thread (the caller), the parsers and the
+    // analyzers so that they add up to threads, or to 3 below that. Tokenizing
+    // and stemming is the expensive stage, it gets what the others leave.
+    static PipelineOptions forThreads(size_t threads);
+};
+
+// Indexes the articles of a DocumentTable in four stages:
+//
+//   read     load the file into a buffer     (UringFileReader, WorkStealingPool
+//            or copied from memory or a stream: an ArticlePack, a JSON Lines feed)
+//   parse    extract the indexed JSON fields, fill in the table
+//   analyze  tokenize and stem text and entities
+//   index    add the terms to the thread's PartialIndex
+//
+// Stages run concurrently and hand articles over through bounded lock-free
+// queues, so reading files overlaps with the CPU bound stages and only
+// queueDepth articles per queue are in flight at any time.
+class IngestPipeline {
+private:
+    PipelineOptions options;
+    bool usedUring = false;
+    bool usedMemory = false;
+    bool usedStream = false;
+    QueueMetrics readQueue;
+    QueueMetrics parseQueue;
+    QueueMetrics analyzeQueue;
+
+    // Starts the other stages, runs read(raw, spare) on this thread and waits for the rest
+    template <typename ReadStage>
+    void runStages(DocumentTable& documents, std::vector<std::unique_ptr<PartialIndex>>& partials,
+                   ReadStage read);
+
+public:
+    // Contents of the article with a document ID
+    using ArticleSource = std::function<std::string_view(size_t index)>;
+    // Next article of a stream: registers it in the table, sets docId and
+    // fills json (a recycled buffer) with its null-terminated contents.
+    // False at the end of the stream.
+    using ArticleStream = std::function<bool(uint32_t& docId, std::vector<char>& json)>;
+
+    explicit IngestPipeline(const PipelineOptions& options);
+
+    // Documents must already be registered in the table. With a source, their
+    // articles are taken from it instead of from the files at their paths.
+    void run(DocumentTable& documents, std::vector<std::unique_ptr<PartialIndex>>& partials,
+             const ArticleSource& source = nullptr);
+    // Indexes a stream of unknown length, registering documents as they come
+    void runStream(DocumentTable& documents, std::vector<std::unique_ptr<PartialIndex>>& partials,
+                   const ArticleStream& stream);
+    // Queue depths and stall times of the last run
+    void printMetrics(std::ostream& out) const;
+};
+
+#endif // INGEST_PIPELINE_H
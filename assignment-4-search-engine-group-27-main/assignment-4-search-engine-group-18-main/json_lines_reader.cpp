@@ -0,0 +1,105 @@
+// json_lines_reader.cpp
+#include "json_lines_reader.h"
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+
+static bool isJsonSpace(char ch) {
+    return ch == ' ' || ch == '\n' || ch == '\r' || ch == '\t';
+}
+
+JsonLinesReader::JsonLinesReader(size_t bufferSize)
+    : file(nullptr), ownsFile(false), buffer(bufferSize), begin(0), end(0), bufferOffset(0), atEnd(true),
+      readFailed(false) {}
+
+JsonLinesReader::~JsonLinesReader() {
+    close();
+}
+
+bool JsonLinesReader::open(const std::string& fileName) {
+    close();
+    if (fileName == "-") {
+        file = stdin;
+        name = "stdin";
+    } else {
+        file = std::fopen(fileName.c_str(), "rb");
+        ownsFile = true;
+        name = fileName;
+        if (file == nullptr) {
+            std::cerr << "cannot open file: " << fileName << std::endl;
+            return false;
+        }
+    }
+    atEnd = false;
+    return true;
+}
+
+void JsonLinesReader::close() {
+    if (file != nullptr && ownsFile) {
+        std::fclose(file);
+    }
+    file = nullptr;
+    ownsFile = false;
+    begin = 0;
+    end = 0;
+    bufferOffset = 0;
+    atEnd = true;
+    readFailed = false;
+}
+
+// Keeps the bytes not handed out yet and tops the buffer up behind them
+void JsonLinesReader::fill() {
+    if (begin > 0) {
+        std::memmove(buffer.data(), buffer.data() + begin, end - begin);
+        end -= begin;
+        bufferOffset += begin;
+        begin = 0;
+    }
+    if (atEnd || end == buffer.size()) {
+        return;
+    }
+
+    // fread only comes back short at the end of the feed, also on a pipe
+    size_t wanted = buffer.size() - end;
+    size_t count = std::fread(buffer.data() + end, 1, wanted, file);
+    end += count;
+    if (count < wanted) {
+        if (std::ferror(file)) {
+            std::cerr << "cannot read file: " << name << std::endl;
+            readFailed = true;
+        }
+        atEnd = true;
+    }
+}
+
+bool JsonLinesReader::next(JsonRecord& record) {
+    while (true) {
+        while (begin < end && isJsonSpace(buffer[begin])) {
+            ++begin;
+        }
+
+        const void* newline = std::memchr(buffer.data() + begin, '\n', end - begin);
+        if (newline != nullptr || (atEnd && begin < end)) {
+            // The last line of a feed may lack its line break
+            size_t lineEnd = newline ? static_cast<const char*>(newline) - buffer.data() : end;
+            record.offset = bufferOffset + begin;
+            record.json = std::string_view(buffer.data() + begin, lineEnd - begin);
+            begin = newline ? lineEnd + 1 : end;
+            return true;
+        }
+        if (atEnd) {
+            return false;
+        }
+
+        if (begin == 0 && end == buffer.size()) {
+            // One line fills the whole buffer
+            buffer.resize(2 * buffer.size());
+        }
+        fill();
+    }
+}
+
+bool JsonLinesReader::isJsonLines(const std::string& fileName) {
+    std::string extension = std::filesystem::path(fileName).extension().string();
+    return fileName == "-" || extension == ".jsonl" || extension == ".ndjson";
+}
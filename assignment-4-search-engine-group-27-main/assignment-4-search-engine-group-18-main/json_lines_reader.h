@@ -0,0 +1,61 @@
+#ifndef JSON_LINES_READER_H
+#define JSON_LINES_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// One record of a JSON Lines feed
+struct JsonRecord {
+    uint64_t offset; // of its first byte in the feed
+    std::string_view json;
+};
+
+// Splits a JSON Lines feed, one article object per line as the crawler
+// writes them, into records without loading it whole. JSON escapes line
+// breaks inside strings, so every line is one record and finding them is a
+// memchr; the parse stage parses each record exactly once. The feed is read
+// into a large buffer that rolls forward: a line cut off at the end of the
+// buffer is moved to the front and completed by the next read. A line
+// longer than the whole buffer grows it.
+class JsonLinesReader {
+private:
+    std::FILE* file;
+    bool ownsFile; // false for standard input
+    std::string name;
+    std::vector<char> buffer;
+    size_t begin;          // first byte not handed out yet
+    size_t end;            // end of the data read so far
+    uint64_t bufferOffset; // feed offset of buffer[0]
+    bool atEnd;
+    bool readFailed;
+
+    void fill();
+
+public:
+    static constexpr size_t defaultBufferSize = 16 * 1024 * 1024;
+
+    explicit JsonLinesReader(size_t bufferSize = defaultBufferSize);
+    ~JsonLinesReader();
+    JsonLinesReader(const JsonLinesReader&) = delete;
+    JsonLinesReader& operator=(const JsonLinesReader&) = delete;
+
+    // "-" reads standard input
+    bool open(const std::string& fileName);
+    void close();
+    // The next non-blank line, without its line break. The view stays valid
+    // until the next call. False once the feed is exhausted.
+    bool next(JsonRecord& record);
+    // The file name, or "stdin"
+    const std::string& getName() const { return name; }
+    // True if reading stopped on an I/O error rather than the end of the feed
+    bool failed() const { return readFailed; }
+
+    // "-" or a .jsonl / .ndjson file
+    static bool isJsonLines(const std::string& fileName);
+};
+
+#endif // JSON_LINES_READER_H
@@ -1,199 +1,414 @@
 #include <iostream>
 #include "document_parser.h"
+#include "document_table.h"
+#include "query_processor.h"
+#include "index_file.h"
+#include "index_builder.h"
+#include "work_stealing_pool.h"
+#include "ingest_pipeline.h"
+#include "stem_cache.h"
+#include "article_pack.h"
+#include "json_lines_reader.h"
 #include <vector>
-#include <algorithm>
-#include <set>
 #include <chrono>
 #include <fstream>
+#include <sstream>
+#include <iterator>
 #include <filesystem>
+#include <cstdlib>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <random>
+#include <cerrno>
+#include <cstdint>
 
 using namespace std;
 using namespace std::chrono;
 
-void clearIndexFiles() {
-    std::vector<std::string> indexFiles = {"mainIndex.txt", "organizationIndex.txt", "personIndex.txt"};
+// Files that make up the persisted index
+const string mainIndexFile = "mainIndex.bin";
+const string organizationIndexFile = "organizationIndex.bin";
+const string personIndexFile = "personIndex.bin";
+const string documentTableFile = "documentTable.bin";
 
-    for (const auto& file : indexFiles) {
-        // Check if the file exists, and if so, remove it
-        if (std::filesystem::exists(file)) {
-            std::filesystem::remove(file);
-        }
+void printUsage() {
+    cout << "Usage:\n"
+         << "\tIndex all files in <directory> and store the index in one or several files:\n"
+         << "\tsupersearch index [options] <directory, pack or .jsonl feed, - for stdin>\n"
+         << "\t  --mem-budget <MB>   memory for postings before runs are spilled (default "
+         << defaultIndexMemoryBudget / (1024 * 1024) << ")\n"
+         << "\t  --threads <n>       divide n threads among the stages (default: all cores)\n"
+         << "\t  --reads-in-flight <n> files read at once through io_uring (Linux)\n"
+         << "\t  --readers <n>       threads loading files where io_uring is unavailable\n"
+         << "\t  --parsers <n>       threads parsing JSON\n"
+         << "\t  --analyzers <n>     threads tokenizing and stemming\n"
+         << "\t  --indexers <n>      threads adding terms to the index\n"
+         << "\t  --queue-depth <n>   articles buffered between two stages\n\n"
+         << "\tCopy all articles in <directory> into one pack file that index reads front to back:\n"
+         << "\tsupersearch pack <directory> <pack>\n\n"
+         << "\tLoad the existing index and perform the following query:\n"
+         << "\tsupersearch query \"social network PERSON:cramer\"\n\n"
+         << "\tStart a simple text-based user interface that lets the user create an index,\n\tload the index and perform multiple queries:\n"
+         << "\tsupersearch ui\n\n";
+}
+
+// Prints the ranked results, resolving the IDs only now for the result page
+void printResults(const vector<SearchResult>& results, const DocumentTable& documents) {
+    int rank = 1;
+    for (const auto& result : results) {
+        DocumentInfo document = documents.get(result.docId);
+        cout << rank++ << ". " << document.path << " (score " << result.score << ")" << endl;
+        cout << "    " << document.title << endl;
+        cout << "    " << document.url << endl;
     }
 }
 
+// Share of stemmer calls answered by the thread-local stem caches so far
+double stemCacheHitRate() {
+    uint64_t hits = StemCache::totalHitCount();
+    uint64_t lookups = hits + StemCache::totalMissCount();
+    return lookups == 0 ? 0.0 : 100.0 * hits / lookups;
+}
 
-void printMergedSets(const set<string>& uniqueSet, const set<string>& uniqueSetOrg, const set<string>& uniqueSetPerson) {
-    // Merge the sets
-    set<string> mergedSet;
-    mergedSet.insert(uniqueSet.begin(), uniqueSet.end());
-    mergedSet.insert(uniqueSetOrg.begin(), uniqueSetOrg.end());
-    mergedSet.insert(uniqueSetPerson.begin(), uniqueSetPerson.end());
+// Parses every article below directory, in a pack or in a JSON Lines feed, each index thread feeds its own partial index.
+// False if the input could not be read, nothing is worth saving then.
+bool buildIndex(const string& directory, vector<unique_ptr<PartialIndex>>& partials, DocumentTable& documents,
+                IngestPipeline& pipeline) {
+    auto indexingStart = high_resolution_clock::now();
+    DocumentParser::resetCounters();
 
-    // Count the frequency of each string in the merged set
-    vector<pair<string, int>> frequencyVector;
-    for (const auto& str : mergedSet) {
-        int frequency = 0;
-        frequency += uniqueSet.count(str);
-        frequency += uniqueSetOrg.count(str);
-        frequency += uniqueSetPerson.count(str);
-        frequencyVector.emplace_back(str, frequency);
+    error_code error;
+    if (JsonLinesReader::isJsonLines(directory)) {
+        if (!DocumentParser::readJsonLines(directory, partials, documents, pipeline)) {
+            return false;
+        }
+    } else if (filesystem::is_regular_file(directory, error) && ArticlePack::isPack(directory)) {
+        if (!DocumentParser::readPack(directory, partials, documents, pipeline)) {
+            return false;
+        }
+    } else if (!DocumentParser::readFileSystem(directory, partials, documents, pipeline)) { //Loading data from the dataset
+        return false;
     }
 
-    // Sort the vector based on frequencies in descending order
-    sort(frequencyVector.begin(), frequencyVector.end(),
-         [](const auto& a, const auto& b) {
-             return a.second > b.second;
-         });
+    auto indexingStop = high_resolution_clock::now();
+    auto indexingDuration = duration_cast<milliseconds>(indexingStop - indexingStart);
 
-    // Print the sorted container
-    for (const auto& [str, frequency] : frequencyVector) {
-        cout << str << ": " << frequency << endl;
+    // Articles that could not be read or parsed keep their ID but are not counted
+    int indexed = DocumentParser::getTotalArticlesProcessed();
+    cout << "Indexed " << indexed << " articles in " << indexingDuration.count() << " ms";
+    if (documents.size() > static_cast<uint32_t>(indexed)) {
+        cout << " (" << documents.size() - indexed << " skipped)";
     }
+    cout << endl;
+    pipeline.printMetrics(cout);
+    cout << "Stem cache hit rate: " << stemCacheHitRate() << " %" << endl;
+
+    // Save stats to a file
+    ofstream statsFile("stats.txt");
+    if (statsFile.is_open()) {
+        statsFile << "Indexing Time: " << indexingDuration.count() << " ms\n";// Output indexing time
+        statsFile << "Total Number of Individual Articles: " << DocumentParser::getTotalArticlesProcessed()<< "\n";// Output total number of individual articles
+        statsFile << "Total Number of Unique Words Indexed: " << DocumentParser::getTotalUniqueWordsIndexed() << "\n";// Output total number of unique words indexed
+        statsFile << "Stem Cache Hit Rate: " << stemCacheHitRate() << " %\n";
+        pipeline.printMetrics(statsFile);
+        statsFile.close();
+    } else {
+        cerr << "Error opening stats file for writing." << endl;
+    }
+    return true;
 }
 
-int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        cout << "Usage: " << argv[0] << " <search_query>" << endl;
-        return 1;
+// Identifies the files written by one index build, so that openIndex can tell
+// them from the files of another build
+uint64_t newBuildId() {
+    random_device random;
+    uint64_t id = (static_cast<uint64_t>(random()) << 32) ^ random();
+    return id ^ static_cast<uint64_t>(system_clock::now().time_since_epoch().count());
+}
+
+// Merges the runs of all partial indices into the final index files. Everything
+// is written next to the current index first and only renamed over it once all
+// four files are complete, so a failed write (e.g. a full disk) keeps the
+// previous index. False if anything could not be written.
+bool saveIndex(vector<unique_ptr<PartialIndex>>& partials, const DocumentTable& documents, uint64_t buildId) {
+    vector<string> mainRuns;
+    vector<string> organizationRuns;
+    vector<string> personsRuns;
+    bool spilled = true;
+    for (auto& partial : partials) {
+        spilled = partial->mainIndex.releaseRuns(mainRuns) && spilled;
+        spilled = partial->organizationIndex.releaseRuns(organizationRuns) && spilled;
+        spilled = partial->personsIndex.releaseRuns(personsRuns) && spilled;
+    }
+    if (!spilled) {
+        // Some postings are lost, the other runs cannot make a complete index
+        for (const vector<string>* runs : {&mainRuns, &organizationRuns, &personsRuns}) {
+            for (const string& run : *runs) {
+                remove(run.c_str());
+            }
+        }
+        cerr << "Could not write the index runs, the previous index is kept." << endl;
+        return false;
     }
 
-    AVLTree mainIndex;  // Create an instance of AVLTree
-    AVLTree organizationIndex;
-    AVLTree personsIndex;
+    if (mainRuns.size() > 1) {
+        cout << "Merging " << mainRuns.size() << " runs of the main index" << endl;
+    }
+    const string pending = ".new";
+    const string files[] = {mainIndexFile, organizationIndexFile, personIndexFile, documentTableFile};
+    // A failed merge keeps its runs, so they can still be inspected
+    bool written = IndexBuilder::mergeRuns(mainRuns, mainIndexFile + pending) &&
+                   IndexBuilder::mergeRuns(organizationRuns, organizationIndexFile + pending) &&
+                   IndexBuilder::mergeRuns(personsRuns, personIndexFile + pending) &&
+                   documents.saveToFile(documentTableFile + pending, buildId);
+    if (!written) {
+        for (const string& file : files) {
+            remove((file + pending).c_str());
+        }
+        cerr << "Could not write the index, the previous index is kept." << endl;
+        return false;
+    }
 
-    clearIndexFiles();//clear content then reload
-    // Gather stats
-    auto indexingStart = high_resolution_clock::now();
+    // The document table goes last. A crash or failed rename before it leaves
+    // index files whose build ID does not match the table, which openIndex refuses.
+    for (const string& file : files) {
+        if (rename((file + pending).c_str(), file.c_str()) != 0) {
+            cerr << "Error replacing " << file << endl;
+            return false;
+        }
+    }
+    return true;
+}
 
-    DocumentParser::readFileSystem("sample_data", mainIndex, organizationIndex, personsIndex); //Loading data from the dataset
-    vector<string> searchTerms;
-    vector<string> excludeTerms;
+// How an index is built
+struct IndexOptions {
+    size_t memoryBudget = defaultIndexMemoryBudget;
+    size_t indexers = 1; // threads of the index stage, one partial index each
+    PipelineOptions pipeline;
 
-    // Separate inclusion and exclusion terms
-    for (int i = 1; i < argc; ++i) {
-        string term(argv[i]);
-        transform(term.begin(), term.end(), term.begin(), ::tolower);  // Convert to lowercase
+    // Defaults for a machine with threads cores: the index stage gets an eighth,
+    // the other stages share the rest, so no more than threads threads are busy
+    static IndexOptions forThreads(size_t threads) {
+        IndexOptions options;
+        options.indexers = max<size_t>(1, threads / 8);
+        options.pipeline = PipelineOptions::forThreads(threads > options.indexers ? threads - options.indexers : 1);
+        return options;
+    }
+};
 
-        if (term.find("-") == 0) {
-            // Exclude term
-            excludeTerms.push_back(term.substr(1));
-        } else {
-            // Include term
-            searchTerms.push_back(term);
+// Builds the index of directory and writes it to disk. All index threads together
+// keep at most memoryBudget bytes of postings in memory before spilling runs;
+// queries are answered from the mapped files. False if no index was written,
+// an existing one is left as it was.
+bool createIndex(const string& directory,
+                 const IndexOptions& options = IndexOptions::forThreads(WorkStealingPool::defaultThreadCount())) {
+    uint64_t buildId = newBuildId();
+    vector<unique_ptr<PartialIndex>> partials;
+    for (size_t i = 0; i < options.indexers; ++i) {
+        string suffix = ".part" + to_string(i);
+        partials.push_back(make_unique<PartialIndex>(mainIndexFile + suffix, organizationIndexFile + suffix,
+                                                     personIndexFile + suffix,
+                                                     options.memoryBudget / options.indexers, buildId));
+    }
+    DocumentTable documents;
+    IngestPipeline pipeline(options.pipeline);
+
+    if (!buildIndex(directory, partials, documents, pipeline)) {
+        // A feed can fail after some batches were already spilled
+        for (auto& partial : partials) {
+            partial->mainIndex.discard();
+            partial->organizationIndex.discard();
+            partial->personsIndex.discard();
+        }
+        return false;
+    }
+    return saveIndex(partials, documents, buildId);
+}
+
+// Unmaps the index so its files can be rewritten
+void closeIndex(IndexFileReader& mainIndex, IndexFileReader& organizationIndex,
+                IndexFileReader& personsIndex, DocumentTable& documents) {
+    mainIndex.close();
+    organizationIndex.close();
+    personsIndex.close();
+    documents.clear();
+}
+
+// Maps the persisted index, which only reads the file headers. False unless all
+// four files were written by the same build.
+bool openIndex(IndexFileReader& mainIndex, IndexFileReader& organizationIndex,
+               IndexFileReader& personsIndex, DocumentTable& documents) {
+    if (!filesystem::exists(documentTableFile)) {
+        cerr << "No index found, run: supersearch index <directory>" << endl;
+        return false;
+    }
+    if (!documents.loadFromFile(documentTableFile) || !mainIndex.open(mainIndexFile) ||
+        !organizationIndex.open(organizationIndexFile) || !personsIndex.open(personIndexFile)) {
+        return false;
+    }
+
+    // Document IDs of another build would point at the wrong articles
+    for (const IndexFileReader* index : {&mainIndex, &organizationIndex, &personsIndex}) {
+        if (index->buildId() != documents.buildId()) {
+            cerr << "The index files are from different builds, run: supersearch index <directory>" << endl;
+            closeIndex(mainIndex, organizationIndex, personsIndex, documents);
+            return false;
         }
     }
+    return true;
+}
 
-    set<string> uniqueSet;
-    set<string> uniqueSetOrg;
-    set<string> uniqueSetPerson;
+// Splits a query line into its terms and prints the ranked results
+void runQuery(const string& query, const QueryProcessor& queryProcessor, const DocumentTable& documents) {
+    auto queryStart = high_resolution_clock::now();
 
-    set<string> uniqueSetExclude;
+    istringstream iss(query);
+    vector<string> queryTerms{istream_iterator<string>(iss), istream_iterator<string>()};
+    vector<SearchResult> results = queryProcessor.search(queryTerms);
 
-    for (const auto& term : searchTerms) {
-        vector<AVLNode*> termResult;  // Results for the current term
+    auto queryStop = high_resolution_clock::now();
 
-        if (term.find("org:") == 0) {
-            organizationIndex.loadFromFile("organizationIndex.txt");
-            std::string orgTerm = term.substr(4);  // Extract organization name
-            orgTerm = DocumentParser::cleanText(orgTerm);
-            termResult = organizationIndex.search(orgTerm);
+    cout << "Sorted Result :" << endl;
+    printResults(results, documents);
+    cout << results.size() << " results in "
+         << duration_cast<microseconds>(queryStop - queryStart).count() / 1000.0 << " ms" << endl;
+}
+
+void runUi() {
+    IndexFileReader mainIndex;
+    IndexFileReader organizationIndex;
+    IndexFileReader personsIndex;
+    DocumentTable documents;
+    QueryProcessor queryProcessor(mainIndex, organizationIndex, personsIndex, documents);
 
-            for (const auto& node : termResult) {
-                vector<string> documents = node->documents;
-                for(const auto& document : documents) {
-                    uniqueSetOrg.insert(document);
-                }
+    string choice;
+    while (true) {
+        cout << "\nPress i to create and save a new index, l to load the index,\n"
+             << "q to run a query or e to exit: ";
+        if (!getline(cin, choice) || choice == "e") {
+            break;
+        }
+
+        if (choice == "i") {
+            string directory;
+            cout << "Directory to index: ";
+            getline(cin, directory);
+            // The old files are still mapped, rewriting them underneath would invalidate the mapping
+            closeIndex(mainIndex, organizationIndex, personsIndex, documents);
+            bool saved = createIndex(directory);
+            if (openIndex(mainIndex, organizationIndex, personsIndex, documents)) {
+                cout << (saved ? "Index saved." : "Indexing failed, loaded the previous index.") << endl;
             }
-        } else if (term.find("person:") == 0) {
-            personsIndex.loadFromFile("personIndex.txt");
-            std::string personTerm = term.substr(7);  // Extract person name
-            personTerm = DocumentParser::cleanText(personTerm);;
-            termResult = personsIndex.search(personTerm);
-
-            for (const auto& node : termResult) {
-                vector<string> documents = node->documents;
-                for(const auto& document : documents) {
-                    uniqueSetPerson.insert(document);
-                }
+        } else if (choice == "l") {
+            if (openIndex(mainIndex, organizationIndex, personsIndex, documents)) {
+                cout << "Loaded an index of " << documents.indexedCount() << " articles." << endl;
             }
+        } else if (choice == "q") {
+            string query;
+            cout << "Query: ";
+            getline(cin, query);
+            runQuery(query, queryProcessor, documents);
         } else {
-            mainIndex.loadFromFile("mainIndex.txt");
-            std::string termSearch = term;
-            std::string wordSearch = DocumentParser::cleanText(termSearch);
-            termResult = mainIndex.search(wordSearch);
-            for (const auto& node : termResult) {
-                vector<string> documents = node->documents;
-                for(const auto& document : documents) {
-                    uniqueSet.insert(document);
-                }
-            }
+            cout << "Unknown option: " << choice << endl;
         }
     }
+}
 
-    for (const auto& term : excludeTerms) {
-        vector<AVLNode*> termResult;
-        if (term.find("org:") == 0) {
-            organizationIndex.loadFromFile("organizationIndex.txt");
-            std::string orgTerm = term.substr(4);  // Extract organization name
-            orgTerm = DocumentParser::cleanText(orgTerm);
-            termResult = organizationIndex.search(orgTerm);
-
-            for (const auto& node : termResult) {
-                vector<string> documents = node->documents;
-                for(const auto& document : documents) {
-                    uniqueSetOrg.erase(document);
-                    uniqueSet.erase(document);
-                    uniqueSetPerson.erase(document);
-                }
-            }
-        } else if (term.find("person:") == 0) {
-            personsIndex.loadFromFile("personIndex.txt");
-            std::string personTerm = term.substr(7);  // Extract person name
-            personTerm = DocumentParser::cleanText(personTerm);;
-            termResult = personsIndex.search(personTerm);
-
-            for (const auto& node : termResult) {
-                vector<string> documents = node->documents;
-                for(const auto& document : documents) {
-                    uniqueSetOrg.erase(document);
-                    uniqueSet.erase(document);
-                    uniqueSetPerson.erase(document);
-                }
-            }
-        } else {
-            mainIndex.loadFromFile("mainIndex.txt");
-            std::string termSearch = term;
-            std::string wordSearch = DocumentParser::cleanText(termSearch);
-            termResult = mainIndex.search(wordSearch);
-            for (const auto& node : termResult) {
-                vector<string> documents = node->documents;
-                for(const auto& document : documents) {
-                    uniqueSetOrg.erase(document);
-                    uniqueSet.erase(document);
-                    uniqueSetPerson.erase(document);
-                }
+// Parses a whole argument as a number greater than zero and at most limit
+bool parsePositive(const char* text, size_t& value, size_t limit = SIZE_MAX) {
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long parsed = strtoull(text, &end, 10);
+    // strtoull would also take a sign and wrap a negative number around
+    if (text[0] < '0' || text[0] > '9' || *end != '\0' || errno == ERANGE || parsed == 0 || parsed > limit) {
+        return false;
+    }
+    value = static_cast<size_t>(parsed);
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        printUsage();
+        return 1;
+    }
+
+    string command = argv[1];
+
+    if (command == "index" && argc >= 3 && argc % 2 == 1) {
+        // --threads picks the defaults, the per-stage options override them
+        size_t threads = WorkStealingPool::defaultThreadCount();
+        for (int i = 2; i + 1 < argc; i += 2) {
+            if (string(argv[i]) == "--threads" && !parsePositive(argv[i + 1], threads)) {
+                cerr << "Invalid option: " << argv[i] << " " << argv[i + 1] << endl;
+                return 1;
             }
         }
-    }
 
-    auto indexingStop = high_resolution_clock::now();
-    auto indexingDuration = duration_cast<milliseconds>(indexingStop - indexingStart);
+        IndexOptions options = IndexOptions::forThreads(threads);
+        size_t memoryBudgetMb = options.memoryBudget / (1024 * 1024);
+        struct Setting {
+            const char* name;
+            size_t* value;
+            size_t limit = SIZE_MAX;
+        };
+        const Setting settings[] = {
+            {"--threads", &threads},
+            {"--mem-budget", &memoryBudgetMb, SIZE_MAX >> 20}, // still fits in bytes
+            {"--reads-in-flight", &options.pipeline.readsInFlight},
+            {"--readers", &options.pipeline.readers},
+            {"--parsers", &options.pipeline.parsers},
+            {"--analyzers", &options.pipeline.analyzers},
+            {"--indexers", &options.indexers},
+            {"--queue-depth", &options.pipeline.queueDepth},
+        };
+        for (int i = 2; i + 1 < argc; i += 2) {
+            auto setting = find_if(begin(settings), end(settings), [&](const Setting& candidate) {
+                return argv[i] == string(candidate.name);
+            });
+            if (setting == end(settings) || !parsePositive(argv[i + 1], *setting->value, setting->limit)) {
+                cerr << "Invalid option: " << argv[i] << " " << argv[i + 1] << endl;
+                printUsage();
+                return 1;
+            }
+        }
+        options.memoryBudget = memoryBudgetMb * 1024 * 1024;
 
+        // Build the index once and persist it, queries only map it
+        if (!createIndex(argv[argc - 1], options)) {
+            return 1;
+        }
+    } else if (command == "query" && argc >= 3) {
+        IndexFileReader mainIndex;
+        IndexFileReader organizationIndex;
+        IndexFileReader personsIndex;
+        DocumentTable documents;
 
-    cout << "Sorted Result :" << endl;
-    printMergedSets(uniqueSet, uniqueSetOrg, uniqueSetPerson);
+        if (!openIndex(mainIndex, organizationIndex, personsIndex, documents)) {
+            return 1;
+        }
 
-    // Save stats to a file
-    ofstream statsFile("stats.txt");
-    if (statsFile.is_open()) {
-        statsFile << "Indexing Time: " << indexingDuration.count() << " ms\n";// Output indexing time
-        statsFile << "Total Number of Individual Articles: " << DocumentParser::getTotalArticlesProcessed()<< "\n";// Output total number of individual articles
-        statsFile << "Total Number of Unique Words Indexed: " << DocumentParser::getTotalUniqueWordsIndexed() << "\n";// Output total number of unique words indexed
-        statsFile.close();
+        // Accept the query as one quoted argument or as several words
+        string query;
+        for (int i = 2; i < argc; ++i) {
+            query += string(argv[i]) + " ";
+        }
+        QueryProcessor queryProcessor(mainIndex, organizationIndex, personsIndex, documents);
+        runQuery(query, queryProcessor, documents);
+    } else if (command == "pack" && argc == 4) {
+        auto packStart = high_resolution_clock::now();
+        if (!DocumentParser::packFileSystem(argv[2], argv[3])) {
+            return 1;
+        }
+        auto packDuration = duration_cast<milliseconds>(high_resolution_clock::now() - packStart);
+        cout << "Packed " << argv[2] << " into " << argv[3] << " in " << packDuration.count() << " ms" << endl;
+    } else if (command == "ui") {
+        runUi();
     } else {
-        cerr << "Error opening stats file for writing." << endl;
+        printUsage();
+        return 1;
     }
 
-
     return 0;
 }
@@ -0,0 +1,86 @@
+// mapped_file.cpp
+#include "mapped_file.h"
+#include <fstream>
+#include <iostream>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define SUPERSEARCH_HAVE_MMAP 1
+#endif
+
+MappedFile::MappedFile() : mapping(nullptr), length(0) {}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& fileName) {
+    close();
+
+#ifdef SUPERSEARCH_HAVE_MMAP
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd < 0) {
+        std::cerr << "Error opening file for reading: " << fileName << std::endl;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        ::close(fd);
+        std::cerr << "Error reading file: " << fileName << std::endl;
+        return false;
+    }
+
+    length = static_cast<size_t>(info.st_size);
+    // mmap cannot map an empty file, but an empty view is still valid
+    void* address = length == 0 ? nullptr : mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps its own reference to the file
+
+    if (address != MAP_FAILED && address != nullptr) {
+        mapping = static_cast<const char*>(address);
+        return true;
+    }
+    if (length != 0) {
+        std::cerr << "Error mapping file, reading it instead: " << fileName << std::endl;
+    }
+#endif
+
+    std::ifstream inFile(fileName, std::ios::binary | std::ios::ate);
+    if (!inFile.is_open()) {
+        std::cerr << "Error opening file for reading: " << fileName << std::endl;
+        return false;
+    }
+    length = static_cast<size_t>(inFile.tellg());
+    inFile.seekg(0);
+    buffer.resize(length + 1); // never empty, so data() is never null
+    if (!inFile.read(buffer.data(), static_cast<std::streamsize>(length))) {
+        std::cerr << "Error reading file: " << fileName << std::endl;
+        buffer.clear();
+        length = 0;
+        return false;
+    }
+    mapping = buffer.data();
+    return true;
+}
+
+void MappedFile::adviseSequential() const {
+#ifdef SUPERSEARCH_HAVE_MMAP
+    if (mapping != nullptr && buffer.empty()) {
+        madvise(const_cast<char*>(mapping), length, MADV_SEQUENTIAL);
+    }
+#endif
+}
+
+void MappedFile::close() {
+#ifdef SUPERSEARCH_HAVE_MMAP
+    if (mapping != nullptr && buffer.empty()) {
+        munmap(const_cast<char*>(mapping), length);
+    }
+#endif
+    mapping = nullptr;
+    length = 0;
+    buffer.clear();
+}
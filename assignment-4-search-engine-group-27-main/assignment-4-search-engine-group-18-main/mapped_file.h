@@ -0,0 +1,34 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Read-only view of a whole file. On POSIX systems the file is mmap'ed, so
+// opening costs the same for any file size, pages are only read when touched
+// and concurrent processes share them through the page cache. Elsewhere the
+// file is read into a buffer.
+class MappedFile {
+private:
+    const char* mapping;
+    size_t length;
+    std::vector<char> buffer; // fallback when mmap is not available
+
+public:
+    MappedFile();
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& fileName);
+    void close();
+    // Hints that the mapping will be read front to back, so the kernel reads ahead
+    void adviseSequential() const;
+
+    const char* data() const { return mapping; }
+    size_t size() const { return length; }
+    bool isOpen() const { return mapping != nullptr; }
+};
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,17 @@
+#ifndef POSTING_H
+#define POSTING_H
+
+#include <cstdint>
+#include <vector>
+#include "arena.h"
+
+// One entry of a posting list: a document and how often the term occurs in it
+struct Posting {
+    uint32_t docId;     // ID from the DocumentTable
+    uint32_t frequency; // term frequency within that document
+};
+
+// Postings of one term in memory, kept in the arena of the IndexBuilder or AVLTree
+using PostingList = std::vector<Posting, ArenaAllocator<Posting>>;
+
+#endif // POSTING_H
@@ -0,0 +1,233 @@
+// posting_codec.cpp
+#include "posting_codec.h"
+#include <cstring>
+
+// SUPERSEARCH_NO_SIMD forces the scalar decoder, so it can be tested on x86
+#if (defined(__SSE2__) || defined(_M_X64)) && !defined(SUPERSEARCH_NO_SIMD)
+#include <emmintrin.h>
+#define SUPERSEARCH_HAVE_SSE2 1
+#endif
+
+static void writeVarint(uint32_t value, std::string& out) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+static const char* readVarint(const char* in, uint32_t& value) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    value = 0;
+    int shift = 0;
+    while (*bytes & 0x80) {
+        value |= static_cast<uint32_t>(*bytes++ & 0x7F) << shift;
+        shift += 7;
+    }
+    value |= static_cast<uint32_t>(*bytes++) << shift;
+    return reinterpret_cast<const char*>(bytes);
+}
+
+// Number of bits needed for the largest of the 128 values
+static uint32_t bitWidth(const uint32_t* values) {
+    uint32_t combined = 0;
+    for (size_t i = 0; i < postingBlockSize; ++i) {
+        combined |= values[i];
+    }
+    uint32_t bits = 0;
+    while (combined != 0) {
+        ++bits;
+        combined >>= 1;
+    }
+    return bits;
+}
+
+// Packs 128 values into bits * 4 words, value i goes to lane i % 4
+static void packBlock(const uint32_t* in, uint32_t bits, uint32_t* out) {
+    if (bits == 0)
+        return;
+
+    for (size_t lane = 0; lane < 4; ++lane) {
+        uint32_t current = 0;
+        uint32_t shift = 0;
+        size_t word = 0;
+        for (size_t j = 0; j < 32; ++j) {
+            uint32_t value = in[4 * j + lane];
+            current |= value << shift;
+            shift += bits;
+            if (shift >= 32) {
+                out[4 * word++ + lane] = current;
+                shift -= 32;
+                current = shift > 0 ? value >> (bits - shift) : 0;
+            }
+        }
+    }
+}
+
+#ifdef SUPERSEARCH_HAVE_SSE2
+// Unpacks 128 values and undoes the stride-4 deltas, four lanes at a time
+static void unpackDeltas(const char* in, uint32_t bits, uint32_t previous, uint32_t* out) {
+    __m128i running = _mm_set1_epi32(static_cast<int>(previous));
+    __m128i* target = reinterpret_cast<__m128i*>(out);
+    if (bits == 0) {
+        for (size_t j = 0; j < 32; ++j) {
+            _mm_storeu_si128(target + j, running);
+        }
+        return;
+    }
+
+    const __m128i* source = reinterpret_cast<const __m128i*>(in);
+    __m128i mask = _mm_set1_epi32(bits == 32 ? -1 : static_cast<int>((1u << bits) - 1));
+    __m128i word = _mm_loadu_si128(source);
+    uint32_t shift = 0;
+    for (size_t j = 0; j < 32; ++j) {
+        __m128i value = _mm_srl_epi32(word, _mm_cvtsi32_si128(static_cast<int>(shift)));
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            if (shift > 0 || j < 31) {
+                word = _mm_loadu_si128(++source);
+                if (shift > 0) {
+                    __m128i high = _mm_sll_epi32(word, _mm_cvtsi32_si128(static_cast<int>(bits - shift)));
+                    value = _mm_or_si128(value, high);
+                }
+            }
+        }
+        running = _mm_add_epi32(running, _mm_and_si128(value, mask));
+        _mm_storeu_si128(target + j, running);
+    }
+}
+
+static void unpackValues(const char* in, uint32_t bits, uint32_t* out) {
+    __m128i* target = reinterpret_cast<__m128i*>(out);
+    if (bits == 0) {
+        for (size_t j = 0; j < 32; ++j) {
+            _mm_storeu_si128(target + j, _mm_setzero_si128());
+        }
+        return;
+    }
+
+    const __m128i* source = reinterpret_cast<const __m128i*>(in);
+    __m128i mask = _mm_set1_epi32(bits == 32 ? -1 : static_cast<int>((1u << bits) - 1));
+    __m128i word = _mm_loadu_si128(source);
+    uint32_t shift = 0;
+    for (size_t j = 0; j < 32; ++j) {
+        __m128i value = _mm_srl_epi32(word, _mm_cvtsi32_si128(static_cast<int>(shift)));
+        shift += bits;
+        if (shift >= 32) {
+            shift -= 32;
+            if (shift > 0 || j < 31) {
+                word = _mm_loadu_si128(++source);
+                if (shift > 0) {
+                    __m128i high = _mm_sll_epi32(word, _mm_cvtsi32_si128(static_cast<int>(bits - shift)));
+                    value = _mm_or_si128(value, high);
+                }
+            }
+        }
+        _mm_storeu_si128(target + j, _mm_and_si128(value, mask));
+    }
+}
+#else
+// Scalar version of the same lane layout
+static void unpackValues(const char* in, uint32_t bits, uint32_t* out) {
+    if (bits == 0) {
+        std::memset(out, 0, postingBlockSize * sizeof(uint32_t));
+        return;
+    }
+
+    uint32_t words[postingBlockSize];
+    std::memcpy(words, in, bits * 4 * sizeof(uint32_t));
+    uint32_t mask = bits == 32 ? ~0u : (1u << bits) - 1;
+    for (size_t lane = 0; lane < 4; ++lane) {
+        size_t index = 0;
+        uint32_t word = words[lane];
+        uint32_t shift = 0;
+        for (size_t j = 0; j < 32; ++j) {
+            uint32_t value = word >> shift;
+            shift += bits;
+            if (shift >= 32) {
+                shift -= 32;
+                if (shift > 0 || j < 31) {
+                    word = words[4 * ++index + lane];
+                    if (shift > 0) {
+                        value |= word << (bits - shift);
+                    }
+                }
+            }
+            out[4 * j + lane] = value & mask;
+        }
+    }
+}
+
+static void unpackDeltas(const char* in, uint32_t bits, uint32_t previous, uint32_t* out) {
+    unpackValues(in, bits, out);
+    for (size_t i = 0; i < postingBlockSize; ++i) {
+        out[i] += i < 4 ? previous : out[i - 4];
+    }
+}
+#endif
+
+void encodePostings(const Posting* postings, size_t count, std::string& out) {
+    uint32_t previous = 0;
+    size_t i = 0;
+
+    uint32_t deltas[postingBlockSize];
+    uint32_t frequencies[postingBlockSize];
+    uint32_t packed[postingBlockSize];
+    for (; i + postingBlockSize <= count; i += postingBlockSize) {
+        const Posting* block = postings + i;
+        for (size_t j = 0; j < postingBlockSize; ++j) {
+            deltas[j] = block[j].docId - (j < 4 ? previous : block[j - 4].docId);
+            frequencies[j] = block[j].frequency;
+        }
+        previous = block[postingBlockSize - 1].docId;
+
+        uint32_t docBits = bitWidth(deltas);
+        uint32_t freqBits = bitWidth(frequencies);
+        out.push_back(static_cast<char>(docBits));
+        out.push_back(static_cast<char>(freqBits));
+        packBlock(deltas, docBits, packed);
+        out.append(reinterpret_cast<const char*>(packed), docBits * 4 * sizeof(uint32_t));
+        packBlock(frequencies, freqBits, packed);
+        out.append(reinterpret_cast<const char*>(packed), freqBits * 4 * sizeof(uint32_t));
+    }
+
+    // Rare terms and the tail of long lists
+    for (; i < count; ++i) {
+        writeVarint(postings[i].docId - previous, out);
+        writeVarint(postings[i].frequency, out);
+        previous = postings[i].docId;
+    }
+}
+
+const char* decodePostings(const char* in, size_t count, Posting* out) {
+    uint32_t previous = 0;
+    size_t i = 0;
+
+    uint32_t docIds[postingBlockSize];
+    uint32_t frequencies[postingBlockSize];
+    for (; i + postingBlockSize <= count; i += postingBlockSize) {
+        uint32_t docBits = static_cast<unsigned char>(in[0]);
+        uint32_t freqBits = static_cast<unsigned char>(in[1]);
+        in += 2;
+        unpackDeltas(in, docBits, previous, docIds);
+        in += docBits * 4 * sizeof(uint32_t);
+        unpackValues(in, freqBits, frequencies);
+        in += freqBits * 4 * sizeof(uint32_t);
+
+        for (size_t j = 0; j < postingBlockSize; ++j) {
+            out[i + j] = {docIds[j], frequencies[j]};
+        }
+        previous = docIds[postingBlockSize - 1];
+    }
+
+    for (; i < count; ++i) {
+        uint32_t delta;
+        uint32_t frequency;
+        in = readVarint(in, delta);
+        in = readVarint(in, frequency);
+        previous += delta;
+        out[i] = {previous, frequency};
+    }
+    return in;
+}
@@ -0,0 +1,36 @@
+#ifndef POSTING_CODEC_H
+#define POSTING_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "posting.h"
+
+// Compressed encoding of a sorted posting list.
+//
+// Document IDs are delta encoded. Lists are cut into blocks of 128 postings;
+// every full block is bit-packed with the smallest width that fits its
+// largest value, the remaining tail (and every list shorter than one block)
+// is written as variable-byte integers.
+//
+// A packed block is
+//
+//   uint8_t   bit width of the document deltas
+//   uint8_t   bit width of the frequencies
+//   uint32_t  docBits * 4 words of packed deltas
+//   uint32_t  freqBits * 4 words of packed frequencies
+//
+// The 128 values are packed in four interleaved lanes (value i goes to lane
+// i % 4) and deltas are taken against the value four positions back, so
+// one SSE2 register decodes four postings at a time. The scalar decoder
+// reads the same layout.
+
+constexpr size_t postingBlockSize = 128;
+
+// Appends the encoding of postings (sorted by docId) to out
+void encodePostings(const Posting* postings, size_t count, std::string& out);
+
+// Decodes count postings from in into out, returns the first byte after them
+const char* decodePostings(const char* in, size_t count, Posting* out);
+
+#endif // POSTING_CODEC_H
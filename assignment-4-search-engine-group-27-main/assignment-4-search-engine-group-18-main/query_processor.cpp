@@ -0,0 +1,125 @@
+// query_processor.cpp
+#include "query_processor.h"
+#include "document_parser.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <string_view>
+
+// Splits cleaned query text into whitespace separated terms that view into text
+static std::vector<std::string_view> splitTerms(const std::string& text) {
+    std::vector<std::string_view> terms;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t start = text.find_first_not_of(" \t\n", pos);
+        if (start == std::string::npos)
+            break;
+        size_t end = text.find_first_of(" \t\n", start);
+        if (end == std::string::npos)
+            end = text.size();
+        terms.emplace_back(text.data() + start, end - start);
+        pos = end;
+    }
+    return terms;
+}
+
+QueryProcessor::QueryProcessor(const IndexFileReader &mainIndex, const IndexFileReader &organizationIndex,
+                               const IndexFileReader &personsIndex, const DocumentTable &documents)
+    : mainIndex(mainIndex), organizationIndex(organizationIndex),
+      personsIndex(personsIndex), documents(documents) {}
+
+double QueryProcessor::idf(size_t documentFrequency) const {
+    // Articles that failed to read or parse still hold an ID but are not part of the collection
+    double n = documents.indexedCount();
+    double df = static_cast<double>(documentFrequency);
+    return std::log(1.0 + (n - df + 0.5) / (df + 0.5));
+}
+
+void QueryProcessor::scoreTerms(const IndexFileReader &index, std::string text, bool normalizeLength,
+                                std::unordered_map<uint32_t, double> &scores) const {
+    std::string cleaned = DocumentParser::cleanText(text);
+    double averageLength = std::max(documents.averageLength(), 1.0);
+    std::vector<Posting> postings;
+
+    for (std::string_view term : splitTerms(cleaned)) {
+        TermEntry entry;
+        if (!index.find(term, entry))
+            continue;
+
+        postings.resize(entry.postingCount);
+        index.readPostings(entry, postings.data());
+        double termIdf = idf(postings.size());
+        for (const Posting& posting : postings) {
+            double tf = posting.frequency;
+            // Entity lists are short and not part of the article length, so only
+            // the text index is length normalized
+            double norm = normalizeLength
+                ? k1 * (1.0 - b + b * documents.getLength(posting.docId) / averageLength)
+                : k1;
+            scores[posting.docId] += termIdf * tf * (k1 + 1.0) / (tf + norm);
+        }
+    }
+}
+
+void QueryProcessor::collectDocuments(const IndexFileReader &index, std::string text,
+                                      std::unordered_set<uint32_t> &result) const {
+    std::string cleaned = DocumentParser::cleanText(text);
+    std::vector<Posting> postings;
+    for (std::string_view term : splitTerms(cleaned)) {
+        TermEntry entry;
+        if (!index.find(term, entry))
+            continue;
+
+        postings.resize(entry.postingCount);
+        index.readPostings(entry, postings.data());
+        for (const Posting& posting : postings) {
+            result.insert(posting.docId);
+        }
+    }
+}
+
+std::vector<SearchResult> QueryProcessor::search(const std::vector<std::string> &queryTerms, size_t k) const {
+    std::unordered_map<uint32_t, double> scores;
+    std::unordered_set<uint32_t> excluded;
+
+    for (std::string term : queryTerms) {
+        std::transform(term.begin(), term.end(), term.begin(), ::tolower);  // Convert to lowercase
+
+        bool exclude = !term.empty() && term[0] == '-';
+        if (exclude) {
+            term = term.substr(1);
+        }
+
+        const IndexFileReader* index = &mainIndex;
+        if (term.find("org:") == 0) {
+            index = &organizationIndex;
+            term = term.substr(4);  // Extract organization name
+        } else if (term.find("person:") == 0) {
+            index = &personsIndex;
+            term = term.substr(7);  // Extract person name
+        }
+
+        if (exclude) {
+            collectDocuments(*index, term, excluded);
+        } else {
+            scoreTerms(*index, term, index == &mainIndex, scores);
+        }
+    }
+
+    std::vector<SearchResult> results;
+    results.reserve(scores.size());
+    for (const auto& [docId, score] : scores) {
+        if (excluded.count(docId) == 0) {
+            results.push_back({docId, score});
+        }
+    }
+
+    // Only the top k need to be in order
+    auto byScore = [](const SearchResult& a, const SearchResult& c) {
+        return a.score != c.score ? a.score > c.score : a.docId < c.docId;
+    };
+    size_t top = std::min(k, results.size());
+    std::partial_sort(results.begin(), results.begin() + top, results.end(), byScore);
+    results.resize(top);
+    return results;
+}
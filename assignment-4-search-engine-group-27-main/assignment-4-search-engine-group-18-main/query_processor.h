@@ -0,0 +1,47 @@
+#ifndef QUERY_PROCESSOR_H
+#define QUERY_PROCESSOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "index_file.h"
+#include "document_table.h"
+
+struct SearchResult {
+    uint32_t docId;
+    double score;
+};
+
+// Ranks documents with BM25 using only the postings and the document table,
+// so answering a query never has to reopen the JSON files. The indices are the
+// memory-mapped files written by the indexer, so nothing is loaded up front.
+class QueryProcessor {
+private:
+    const IndexFileReader &mainIndex;
+    const IndexFileReader &organizationIndex;
+    const IndexFileReader &personsIndex;
+    const DocumentTable &documents;
+
+    double idf(size_t documentFrequency) const;
+    // Adds the BM25 contribution of every term in text to scores
+    void scoreTerms(const IndexFileReader &index, std::string text, bool normalizeLength,
+                    std::unordered_map<uint32_t, double> &scores) const;
+    // Collects every document that contains one of the terms in text
+    void collectDocuments(const IndexFileReader &index, std::string text,
+                          std::unordered_set<uint32_t> &result) const;
+
+public:
+    static constexpr double k1 = 1.2;
+    static constexpr double b = 0.75;
+
+    QueryProcessor(const IndexFileReader &mainIndex, const IndexFileReader &organizationIndex,
+                   const IndexFileReader &personsIndex, const DocumentTable &documents);
+
+    // Terms may carry ORG:/PERSON: prefixes and a leading - to exclude documents
+    std::vector<SearchResult> search(const std::vector<std::string> &queryTerms, size_t k = 15) const;
+};
+
+#endif // QUERY_PROCESSOR_H
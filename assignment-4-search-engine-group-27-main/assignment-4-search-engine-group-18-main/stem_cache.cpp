@@ -0,0 +1,72 @@
+// stem_cache.cpp
+#include "stem_cache.h"
+#include <cstring>
+
+std::atomic<uint64_t> StemCache::totalHits{0};
+std::atomic<uint64_t> StemCache::totalMisses{0};
+
+// Lookups between two updates of the shared totals
+static constexpr uint64_t flushInterval = 1 << 16;
+
+StemCache::StemCache(size_t capacity) : hits(0), misses(0), flushedHits(0), flushedMisses(0) {
+    size_t size = 1;
+    while (size < capacity) {
+        size <<= 1;
+    }
+    slots.assign(size, Slot{});
+}
+
+StemCache::~StemCache() {
+    flush();
+}
+
+// FNV-1a
+uint32_t StemCache::hashWord(std::string_view word) {
+    uint32_t hash = 2166136261u;
+    for (char ch : word) {
+        hash ^= static_cast<unsigned char>(ch);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void StemCache::flush() {
+    totalHits += hits - flushedHits;
+    totalMisses += misses - flushedMisses;
+    flushedHits = hits;
+    flushedMisses = misses;
+}
+
+bool StemCache::lookup(std::string_view word, char* stem, size_t& stemLength) {
+    if ((hits + misses) - (flushedHits + flushedMisses) >= flushInterval) {
+        flush();
+    }
+
+    if (word.size() <= maxWordLength) {
+        uint32_t hash = hashWord(word);
+        const Slot& slot = slots[hash & (slots.size() - 1)];
+        if (slot.wordLength == word.size() && slot.hash == hash &&
+            std::memcmp(slot.word, word.data(), word.size()) == 0) {
+            stemLength = slot.stemLength;
+            std::memcpy(stem, slot.stem, stemLength);
+            ++hits;
+            return true;
+        }
+    }
+    ++misses;
+    return false;
+}
+
+void StemCache::insert(std::string_view word, std::string_view stem) {
+    if (word.empty() || word.size() > maxWordLength || stem.size() > maxWordLength) {
+        return;
+    }
+
+    uint32_t hash = hashWord(word);
+    Slot& slot = slots[hash & (slots.size() - 1)];
+    slot.hash = hash;
+    slot.wordLength = static_cast<uint8_t>(word.size());
+    slot.stemLength = static_cast<uint8_t>(stem.size());
+    std::memcpy(slot.word, word.data(), word.size());
+    std::memcpy(slot.stem, stem.data(), stem.size());
+}
@@ -0,0 +1,59 @@
+#ifndef STEM_CACHE_H
+#define STEM_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Bounded cache from a surface form to its stem, meant to be thread_local.
+// News text is Zipfian, so a few thousand frequent words make up most
+// tokens and are stemmed once per thread instead of once per occurrence.
+// The table is direct mapped: a word has exactly one slot and a colliding
+// word simply replaces it, so memory stays fixed. Words and stems are kept
+// inline in the 64-byte slot; longer words are not cached.
+class StemCache {
+private:
+    static constexpr size_t maxWordLength = 28;
+
+    struct Slot {
+        uint32_t hash;
+        uint8_t wordLength; // 0 marks an empty slot
+        uint8_t stemLength;
+        char word[maxWordLength + 1];
+        char stem[maxWordLength + 1];
+    };
+
+    std::vector<Slot> slots; // size is a power of two
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t flushedHits; // part of hits and misses already in the totals
+    uint64_t flushedMisses;
+
+    // Totals over all threads, updated in batches
+    static std::atomic<uint64_t> totalHits;
+    static std::atomic<uint64_t> totalMisses;
+
+    static uint32_t hashWord(std::string_view word);
+    void flush();
+
+public:
+    explicit StemCache(size_t capacity = 1 << 15);
+    ~StemCache();
+    StemCache(const StemCache&) = delete;
+    StemCache& operator=(const StemCache&) = delete;
+
+    // Copies the cached stem of word to stem and returns true, or counts a miss.
+    // stem must hold word.size() bytes and may alias word.
+    bool lookup(std::string_view word, char* stem, size_t& stemLength);
+    void insert(std::string_view word, std::string_view stem);
+
+    uint64_t hitCount() const { return hits; }
+    uint64_t missCount() const { return misses; }
+    // Lookups of every thread, including caches that are already destroyed
+    static uint64_t totalHitCount() { return totalHits.load(); }
+    static uint64_t totalMissCount() { return totalMisses.load(); }
+};
+
+#endif // STEM_CACHE_H
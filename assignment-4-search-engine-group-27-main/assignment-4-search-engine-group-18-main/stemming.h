@@ -13,6 +13,7 @@
 #include <algorithm>
 #include <array>
 #include <cassert>
+#include <type_traits>
 #include "common_lang_constants.h"
 
 /// @brief Namespace for stemming classes.
@@ -155,6 +156,23 @@ namespace stemming
             ch;
         }
 
+    /** @brief Picks the spelling of a string literal that matches a character type.
+        @details Lets a stemmer written against `wchar_t` literals also be
+            instantiated for byte strings (`std::string`), which is only
+            meaningful for stemmers whose alphabet is ASCII.
+        @param narrow The literal as a `char` string.
+        @param wide The same literal as a `wchar_t` string.
+        @returns @c narrow for `char`, @c wide otherwise.*/
+    template <typename charT>
+    [[nodiscard]]
+    inline constexpr const charT* literal(const char* narrow, const wchar_t* wide) noexcept
+        {
+        if constexpr (std::is_same_v<charT, char>)
+            { return narrow; }
+        else
+            { return wide; }
+        }
+
     /** @brief The base class for language-specific stemmers.
         @details The template argument for the stemmers are the type
         of `std::basic_string` that you are trying to stem,
@@ -191,7 +209,7 @@ namespace stemming
         /// @param text The string to review.
         /// @param vowel_list The list of vowels by the stemmer's language.
         void find_r1(const string_typeT& text,
-                     const wchar_t* vowel_list) noexcept
+                     const typename string_typeT::value_type* vowel_list) noexcept
             {
             // see where the R1 section begin
             // R1 is the region after the first consonant after the first vowel
@@ -218,7 +236,7 @@ namespace stemming
         /// @param text The string to review.
         /// @param vowel_list The list of vowels by the stemmer's language.
         void find_r2(const string_typeT& text,
-                     const wchar_t* vowel_list) noexcept
+                     const typename string_typeT::value_type* vowel_list) noexcept
             {
             size_t start = 0;
             // look for R2--not required for all criteria.
@@ -2712,7 +2730,7 @@ namespace stemming
         /// @param text The string to update.
         /// @param vowel_string The list of vowels used by the stemmer's language.
         void hash_y(string_typeT& text,
-                    const wchar_t* vowel_string)
+                    const typename string_typeT::value_type* vowel_string)
             {
             // need at least 2 letters for hashing
             if (text.length() < 2)
@@ -3104,9 +3122,10 @@ namespace stemming
             @param character The character to review.
             @param char_string The list of characters to compare against.
             @returns @c true if the character of one of the list of characters.*/
+        template<typename charT, typename listT>
         [[nodiscard]]
-        inline static constexpr bool is_one_of(const wchar_t character,
-                                               const wchar_t* char_string) noexcept
+        inline static constexpr bool is_one_of(const charT character,
+                                               const listT* char_string) noexcept
             {
             if (!char_string)
                 { return false; }
@@ -3161,9 +3180,9 @@ namespace stemming
         /// @param first The first value to compare against.
         /// @param second The second value to compare against.
         /// @returns @c true if value is either of the other values.
-        template<typename T>
+        template<typename T, typename U>
         [[nodiscard]]
-        static inline constexpr bool is_either(const T value, const T first, const T second) noexcept
+        static inline constexpr bool is_either(const T value, const U first, const U second) noexcept
             { return (value == first || value == second); }
 
         /// @brief Determines if a given value is neither of two other given values.
@@ -3171,9 +3190,9 @@ namespace stemming
         /// @param first The first value to compare against.
         /// @param second The second value to compare against.
         /// @returns @c true if value is neither of the other values.
-        template<typename T>
+        template<typename T, typename U>
         [[nodiscard]]
-        static inline constexpr bool is_neither(const T value, const T first, const T second) noexcept
+        static inline constexpr bool is_neither(const T value, const U first, const U second) noexcept
             {
             assert(first != second);
             return (value != first && value != second);
@@ -0,0 +1,95 @@
+// stop_word_set.cpp
+#include "stop_word_set.h"
+#include <cctype>
+#include <fstream>
+#include <iostream>
+
+static inline unsigned char toLower(char ch) {
+    return static_cast<unsigned char>(std::tolower(static_cast<unsigned char>(ch)));
+}
+
+StopWordSet::StopWordSet() : slots(64, Slot{emptySlot, 0, 0}), count(0) {}
+
+// FNV-1a over the lowercased bytes
+uint32_t StopWordSet::hashWord(std::string_view word) {
+    uint32_t hash = 2166136261u;
+    for (char ch : word) {
+        hash ^= toLower(ch);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+bool StopWordSet::equals(const Slot& slot, std::string_view word) const {
+    if (slot.length != word.size()) {
+        return false;
+    }
+    const char* stored = characters.data() + slot.offset;
+    for (size_t i = 0; i < word.size(); ++i) {
+        if (static_cast<unsigned char>(stored[i]) != toLower(word[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void StopWordSet::insertSlot(const Slot& slot) {
+    size_t mask = slots.size() - 1;
+    size_t i = slot.hash & mask;
+    while (slots[i].offset != emptySlot) {
+        i = (i + 1) & mask;
+    }
+    slots[i] = slot;
+}
+
+void StopWordSet::grow() {
+    std::vector<Slot> old(slots.size() * 2, Slot{emptySlot, 0, 0});
+    old.swap(slots);
+    for (const Slot& slot : old) {
+        if (slot.offset != emptySlot) {
+            insertSlot(slot);
+        }
+    }
+}
+
+void StopWordSet::insert(std::string_view word) {
+    if (word.empty() || contains(word)) {
+        return;
+    }
+    // Keep the load factor at or below one half so probe chains stay short
+    if ((count + 1) * 2 > slots.size()) {
+        grow();
+    }
+
+    Slot slot{static_cast<uint32_t>(characters.size()), static_cast<uint32_t>(word.size()), hashWord(word)};
+    for (char ch : word) {
+        characters.push_back(static_cast<char>(toLower(ch)));
+    }
+    insertSlot(slot);
+    ++count;
+}
+
+bool StopWordSet::contains(std::string_view word) const {
+    uint32_t hash = hashWord(word);
+    size_t mask = slots.size() - 1;
+    for (size_t i = hash & mask; slots[i].offset != emptySlot; i = (i + 1) & mask) {
+        if (slots[i].hash == hash && equals(slots[i], word)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool StopWordSet::loadFromFile(const std::string& fileName) {
+    std::ifstream stopWordsStream(fileName);
+    if (!stopWordsStream.is_open()) {
+        std::cerr << "Error opening stop words file." << std::endl;
+        return false;
+    }
+
+    std::string stopWord;
+    while (stopWordsStream >> stopWord) {
+        insert(stopWord);
+    }
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef STOP_WORD_SET_H
+#define STOP_WORD_SET_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Open-addressing hash set for the stop word list. Words are stored lowercase
+// in one character buffer and lookups are case-insensitive, so checking a
+// token neither copies nor lowercases it.
+class StopWordSet {
+private:
+    struct Slot {
+        uint32_t offset; // into characters, empty slots use emptySlot
+        uint32_t length;
+        uint32_t hash;
+    };
+
+    static constexpr uint32_t emptySlot = UINT32_MAX;
+
+    std::string characters;
+    std::vector<Slot> slots; // size is a power of two, linear probing
+    size_t count;
+
+    static uint32_t hashWord(std::string_view word);
+    bool equals(const Slot& slot, std::string_view word) const;
+    void grow();
+    void insertSlot(const Slot& slot);
+
+public:
+    StopWordSet();
+
+    bool loadFromFile(const std::string& fileName);
+    void insert(std::string_view word);
+    bool contains(std::string_view word) const;
+    size_t size() const { return count; }
+};
+
+#endif // STOP_WORD_SET_H
@@ -0,0 +1,105 @@
+// article_reader_tests.cpp
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+#include "article_reader.h"
+
+// The parse is in situ, so every test parses its own null-terminated copy
+static std::vector<char> buffer(const std::string& json) {
+    std::vector<char> result(json.begin(), json.end());
+    result.push_back('\0');
+    return result;
+}
+
+TEST_CASE("the indexed fields are picked out of an article", "[reader]") {
+    std::vector<char> json = buffer(R"({
+        "uuid": "0001",
+        "thread": {"title": "thread title", "url": "thread url", "social": {"facebook": {"likes": 3}}},
+        "title": "Markets \"rally\"",
+        "url": "https://example.com/a",
+        "text": "Line one\nline two",
+        "entities": {
+            "persons": [{"name": "jane doe", "sentiment": "none"}, {"sentiment": "none", "name": "john smith"}],
+            "organizations": [{"name": "reuters"}, {"name": "acme corp"}],
+            "locations": [{"name": "london"}]
+        },
+        "highlightText": ""
+    })");
+    ArticleReader reader;
+    ArticleFields fields;
+    REQUIRE(reader.parse(json.data(), fields));
+    REQUIRE(fields.title == "Markets \"rally\"");
+    REQUIRE(fields.url == "https://example.com/a");
+    REQUIRE(fields.text == "Line one\nline two");
+    REQUIRE(fields.organizations == "reuters\nacme corp");
+    REQUIRE(fields.persons == "jane doe\njohn smith");
+}
+
+TEST_CASE("the first occurrence of a field wins", "[reader]") {
+    std::vector<char> json = buffer(R"({"title": "first", "title": "second",
+        "entities": {"persons": [{"name": "a", "name": "b"}]},
+        "entities": {"persons": [{"name": "c"}]}})");
+    ArticleReader reader;
+    ArticleFields fields;
+    REQUIRE(reader.parse(json.data(), fields));
+    REQUIRE(fields.title == "first");
+    REQUIRE(fields.persons == "a");
+}
+
+TEST_CASE("fields of the wrong type are ignored", "[reader]") {
+    std::vector<char> json = buffer(R"({"title": 42, "text": ["not", "text"],
+        "entities": {"organizations": {"name": "not a list"}, "persons": [{"name": 7}, "x", {"name": "ok"}]}})");
+    ArticleReader reader;
+    ArticleFields fields;
+    REQUIRE(reader.parse(json.data(), fields));
+    REQUIRE(fields.title.empty());
+    REQUIRE(fields.text.empty());
+    REQUIRE(fields.organizations.empty());
+    REQUIRE(fields.persons == "ok");
+}
+
+TEST_CASE("parsing stops where the article ends", "[reader]") {
+    // A JSON Lines record keeps its line break, and whatever follows is not looked at
+    std::vector<char> json = buffer("{\"title\": \"record\"}\r\n{\"title\": \"next\"} garbage");
+    ArticleReader reader;
+    ArticleFields fields;
+    REQUIRE(reader.parse(json.data(), fields));
+    REQUIRE(fields.title == "record");
+}
+
+TEST_CASE("anything but an object is rejected", "[reader]") {
+    ArticleReader reader;
+    ArticleFields fields;
+    for (const char* text : {"", "   ", "[1, 2]", "\"text\"", "42", "{\"title\": \"cut off", "{\"title\" \"x\"}"}) {
+        INFO("input " << text);
+        std::vector<char> json = buffer(text);
+        REQUIRE_FALSE(reader.parse(json.data(), fields));
+    }
+}
+
+TEST_CASE("an article that is not UTF-8 is rejected", "[reader]") {
+    ArticleReader reader;
+    ArticleFields fields;
+    for (const char* text : {"{\"text\": \"bad \xff\xfe bytes\"}", "{\"text\": \"cut \xc3\"}",
+                             "{\"title\": \"ok\", \"text\": \"stray \x80\"}"}) {
+        std::vector<char> json = buffer(text);
+        REQUIRE_FALSE(reader.parse(json.data(), fields));
+    }
+    std::vector<char> json = buffer("{\"text\": \"caf\xc3\xa9\"}");
+    REQUIRE(reader.parse(json.data(), fields));
+    REQUIRE(fields.text == "caf\xc3\xa9");
+}
+
+TEST_CASE("a reader is reused without leaking fields between articles", "[reader]") {
+    ArticleReader reader;
+    ArticleFields fields;
+    std::vector<char> first = buffer(R"({"title": "one", "entities": {"persons": [{"name": "p"}]}})");
+    REQUIRE(reader.parse(first.data(), fields));
+    REQUIRE(fields.persons == "p");
+
+    std::vector<char> second = buffer(R"({"text": "two"})");
+    REQUIRE(reader.parse(second.data(), fields));
+    REQUIRE(fields.title.empty());
+    REQUIRE(fields.persons.empty());
+    REQUIRE(fields.text == "two");
+}
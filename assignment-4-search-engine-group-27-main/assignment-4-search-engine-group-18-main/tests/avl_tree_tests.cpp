@@ -0,0 +1,121 @@
+// avl_tree_tests.cpp
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "AVLTree.h"
+
+namespace fs = std::filesystem;
+
+// Height of the subtree below node, checking the AVL balance on the way
+static int checkedHeight(const AVLNode* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    int left = checkedHeight(node->left);
+    int right = checkedHeight(node->right);
+    REQUIRE(std::abs(left - right) <= 1);
+    REQUIRE(node->height == 1 + std::max(left, right));
+    if (node->left != nullptr) {
+        REQUIRE(node->left->key < node->key);
+    }
+    if (node->right != nullptr) {
+        REQUIRE(node->key < node->right->key);
+    }
+    return node->height;
+}
+
+TEST_CASE("inserted words are found with their postings", "[avl]") {
+    AVLTree tree;
+    REQUIRE(tree.empty());
+    REQUIRE(tree.search("market") == nullptr);
+
+    tree.insert("market", 0);
+    tree.insert("market", 0);
+    tree.insert("market", 3, 2);
+    tree.insert("apple", 1);
+
+    AVLNode* node = tree.search("market");
+    REQUIRE(node != nullptr);
+    REQUIRE(node->frequency == 4);
+    REQUIRE(node->postings.size() == 2);
+    REQUIRE(node->postings[0].docId == 0);
+    REQUIRE(node->postings[0].frequency == 2);
+    REQUIRE(node->postings[1].docId == 3);
+    REQUIRE(node->postings[1].frequency == 2);
+    REQUIRE(tree.search("apple") != nullptr);
+    REQUIRE(tree.search("banana") == nullptr);
+
+    tree.clear();
+    REQUIRE(tree.empty());
+    REQUIRE(tree.search("market") == nullptr);
+}
+
+TEST_CASE("the tree stays balanced for sorted insertions", "[avl]") {
+    AVLTree tree;
+    std::vector<std::string> words;
+    for (int i = 0; i < 1000; ++i) {
+        words.push_back("word" + std::to_string(100000 + i)); // ascending, the worst case for a plain BST
+    }
+    for (const std::string& word : words) {
+        tree.insert(word, 0);
+    }
+
+    std::vector<std::string_view> queries(words.begin(), words.end());
+    std::vector<AVLNode*> nodes = tree.search(queries);
+    for (size_t i = 0; i < words.size(); ++i) {
+        REQUIRE(nodes[i] != nullptr);
+        REQUIRE(nodes[i]->key == words[i]);
+    }
+    // Every node is some subtree's root, so checking them all covers the tree
+    for (AVLNode* node : nodes) {
+        REQUIRE(checkedHeight(node) <= 15); // 1.44 log2(1000) is about 14.4
+    }
+}
+
+TEST_CASE("insertDocument counts repeated terms once per document", "[avl]") {
+    AVLTree tree;
+    tree.insertDocument(0, {"b", "a", "b", "c", "b"});
+    tree.insertDocument(1, {"b"});
+
+    std::vector<AVLNode*> nodes = tree.search(std::vector<std::string_view>{"b", "a", "missing", "c"});
+    REQUIRE(nodes[0] != nullptr);
+    REQUIRE(nodes[0]->frequency == 4);
+    REQUIRE(nodes[0]->postings.size() == 2);
+    REQUIRE(nodes[0]->postings[0].frequency == 3);
+    REQUIRE(nodes[0]->postings[1].frequency == 1);
+    REQUIRE(nodes[1]->frequency == 1);
+    REQUIRE(nodes[2] == nullptr);
+    REQUIRE(nodes[3]->postings[0].docId == 0);
+}
+
+TEST_CASE("a saved tree loads back balanced with the same postings", "[avl]") {
+    std::string fileName = (fs::temp_directory_path() / "supersearch_test_avl.idx").string();
+    AVLTree tree;
+    for (uint32_t document = 0; document < 200; ++document) {
+        tree.insertDocument(document, {"common", document % 3 == 0 ? "fizz" : "other", "common"});
+    }
+    REQUIRE(tree.saveToFile(fileName));
+
+    AVLTree loaded;
+    loaded.loadFromFile(fileName);
+    fs::remove(fileName);
+
+    for (std::string_view word : {"common", "fizz", "other"}) {
+        INFO("word " << word);
+        AVLNode* original = tree.search(word);
+        AVLNode* copy = loaded.search(word);
+        REQUIRE(copy != nullptr);
+        REQUIRE(checkedHeight(copy) >= 1);
+        REQUIRE(copy->frequency == original->frequency);
+        REQUIRE(copy->postings.size() == original->postings.size());
+        for (size_t i = 0; i < original->postings.size(); ++i) {
+            REQUIRE(copy->postings[i].docId == original->postings[i].docId);
+            REQUIRE(copy->postings[i].frequency == original->postings[i].frequency);
+        }
+    }
+    REQUIRE(loaded.search("missing") == nullptr);
+}
@@ -0,0 +1,119 @@
+// bounded_queue_tests.cpp
+#include <catch2/catch.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+#include "bounded_queue.h"
+
+TEST_CASE("a queue hands out elements in order", "[queue]") {
+    BoundedQueue<int> queue(4);
+    for (int i = 0; i < 3; ++i) {
+        queue.push(i);
+    }
+    REQUIRE(queue.size() == 3);
+
+    int value = -1;
+    for (int i = 0; i < 3; ++i) {
+        REQUIRE(queue.pop(value));
+        REQUIRE(value == i);
+    }
+    REQUIRE_FALSE(queue.tryPop(value));
+}
+
+TEST_CASE("tryPush fails on a full queue and leaves the value alone", "[queue]") {
+    BoundedQueue<std::unique_ptr<int>> queue(3); // rounded up to 4
+    REQUIRE(queue.metrics().capacity == 4);
+    for (int i = 0; i < 4; ++i) {
+        auto value = std::make_unique<int>(i);
+        REQUIRE(queue.tryPush(value));
+        REQUIRE(value == nullptr);
+    }
+
+    auto extra = std::make_unique<int>(4);
+    REQUIRE_FALSE(queue.tryPush(extra));
+    REQUIRE(extra != nullptr);
+    REQUIRE(*extra == 4);
+
+    std::unique_ptr<int> value;
+    REQUIRE(queue.tryPop(value));
+    REQUIRE(*value == 0);
+    REQUIRE(queue.tryPush(extra));
+}
+
+TEST_CASE("a closed queue is drained before pop reports the end", "[queue]") {
+    BoundedQueue<int> queue(8);
+    queue.push(1);
+    queue.push(2);
+    queue.close();
+
+    int value = 0;
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 1);
+    REQUIRE(queue.pop(value));
+    REQUIRE(value == 2);
+    REQUIRE_FALSE(queue.pop(value));
+    REQUIRE_FALSE(queue.pop(value));
+}
+
+TEST_CASE("a waiting consumer wakes up when the queue is closed", "[queue]") {
+    BoundedQueue<int> queue(2);
+    bool received = true;
+    std::thread consumer([&] {
+        int value;
+        received = queue.pop(value);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    queue.close();
+    consumer.join();
+    REQUIRE_FALSE(received);
+}
+
+TEST_CASE("every element reaches exactly one consumer", "[queue]") {
+    const uint32_t producerCount = 4;
+    const uint32_t consumerCount = 3;
+    const uint32_t perProducer = 20000;
+    BoundedQueue<uint32_t> queue(16); // small, so both sides wait
+
+    std::vector<std::vector<uint32_t>> seen(consumerCount);
+    std::vector<std::thread> consumers;
+    for (uint32_t c = 0; c < consumerCount; ++c) {
+        consumers.emplace_back([&queue, &seen, c] {
+            uint32_t value;
+            while (queue.pop(value)) {
+                seen[c].push_back(value);
+            }
+        });
+    }
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < producerCount; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (uint32_t i = 0; i < perProducer; ++i) {
+                queue.push(p * perProducer + i);
+            }
+        });
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    queue.close();
+    for (std::thread& consumer : consumers) {
+        consumer.join();
+    }
+
+    std::vector<uint32_t> counts(producerCount * perProducer, 0);
+    for (const std::vector<uint32_t>& values : seen) {
+        // One producer's elements arrive in the order it pushed them
+        std::vector<int64_t> last(producerCount, -1);
+        for (uint32_t value : values) {
+            ++counts[value];
+            REQUIRE(static_cast<int64_t>(value) > last[value / perProducer]);
+            last[value / perProducer] = value;
+        }
+    }
+    for (uint32_t count : counts) {
+        REQUIRE(count == 1);
+    }
+    REQUIRE(queue.metrics().pushes == producerCount * perProducer);
+}
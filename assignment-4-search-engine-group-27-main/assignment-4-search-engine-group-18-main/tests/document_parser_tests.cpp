@@ -0,0 +1,82 @@
+// document_parser_tests.cpp
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "document_parser.h"
+#include "document_table.h"
+#include "index_builder.h"
+#include "index_file.h"
+#include "ingest_pipeline.h"
+
+namespace fs = std::filesystem;
+
+static std::string stem(std::string_view word) {
+    std::string out(word.size(), '\0');
+    out.resize(DocumentParser::stemInto(word, &out[0]));
+    return out;
+}
+
+TEST_CASE("ASCII and UTF-8 words are stemmed", "[stem]") {
+    REQUIRE(stem("markets") == "market");
+    REQUIRE(stem("running") == "run");
+    REQUIRE(stem("caf\xc3\xa9s") == "caf\xc3\xa9");
+}
+
+TEST_CASE("a word that is not UTF-8 is its own stem", "[stem]") {
+    for (std::string_view word : {std::string_view("bytes\xff\xfe"), std::string_view("\xfe\xff"),
+                                  std::string_view("cut\xc3"), std::string_view("\xc3\xa9\x80s")}) {
+        REQUIRE(stem(word) == word);
+        // Answered from the cache the second time
+        REQUIRE(stem(word) == word);
+    }
+}
+
+TEST_CASE("queries with invalid UTF-8 are cleaned", "[stem]") {
+    REQUIRE(DocumentParser::cleanText("Markets \xff\xfe rallied") == "market \xff\xfe ralli ");
+}
+
+TEST_CASE("a feed record with invalid UTF-8 is skipped, the others are indexed", "[feed]") {
+    fs::path directory = fs::temp_directory_path() / "supersearch_test_feed";
+    fs::remove_all(directory);
+    fs::create_directory(directory);
+    std::string feed = (directory / "feed.jsonl").string();
+    std::ofstream(feed, std::ios::binary) << "{\"title\": \"one\", \"text\": \"markets rallied\"}\n"
+                                          << "{\"title\": \"bad\", \"text\": \"markets \xff\xfe crashed\"}\n"
+                                          << "{\"title\": \"two\", \"text\": \"markets fell\"}\n";
+
+    std::vector<std::unique_ptr<PartialIndex>> partials;
+    std::string prefix = (directory / "run").string();
+    partials.push_back(std::make_unique<PartialIndex>(prefix + ".main", prefix + ".org", prefix + ".person",
+                                                      defaultIndexMemoryBudget));
+    DocumentTable documents;
+    IngestPipeline pipeline{PipelineOptions()};
+    DocumentParser::resetCounters();
+    REQUIRE(DocumentParser::readJsonLines(feed, partials, documents, pipeline));
+
+    REQUIRE(documents.size() == 3);
+    REQUIRE(documents.indexedCount() == 2);
+    REQUIRE(DocumentParser::getTotalArticlesProcessed() == 2);
+
+    std::vector<std::string> runs;
+    REQUIRE(partials[0]->mainIndex.releaseRuns(runs));
+    std::string index = (directory / "main.idx").string();
+    REQUIRE(IndexBuilder::mergeRuns(runs, index));
+    IndexFileReader reader;
+    REQUIRE(reader.open(index));
+    TermEntry entry;
+    REQUIRE(reader.find("market", entry));
+    std::vector<Posting> postings(entry.postingCount);
+    reader.readPostings(entry, postings.data());
+    REQUIRE(postings.size() == 2);
+    REQUIRE(postings[0].docId == 0);
+    REQUIRE(postings[1].docId == 2);
+    REQUIRE_FALSE(reader.find("crash", entry));
+
+    reader.close();
+    partials.clear();
+    fs::remove_all(directory);
+}
@@ -0,0 +1,80 @@
+// document_table_tests.cpp
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "document_table.h"
+
+namespace fs = std::filesystem;
+
+// A document table file in the temporary directory, removed at the end of the test
+class TempTable {
+private:
+    std::string path;
+
+public:
+    explicit TempTable(const std::string& name)
+        : path((fs::temp_directory_path() / ("supersearch_test_" + name)).string()) {
+        DocumentTable documents;
+        documents.setMetadata(documents.addDocument("coll/a.json"), "First", "http://a");
+        documents.setMetadata(documents.addDocument("coll/b.json"), "Second", "http://b");
+        documents.setLength(1, 7);
+        REQUIRE(documents.saveToFile(path));
+    }
+    ~TempTable() { fs::remove(path); }
+    const std::string& name() const { return path; }
+
+    // Overwrites the 64-bit value at offset, as a corrupt or truncated write would
+    void patch(size_t offset, uint64_t value) const {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(static_cast<std::streamoff>(offset));
+        file.write(reinterpret_cast<const char*>(&value), sizeof(value));
+    }
+};
+
+TEST_CASE("a saved document table loads back", "[documents]") {
+    TempTable table("documents");
+    DocumentTable documents;
+    REQUIRE(documents.loadFromFile(table.name()));
+    REQUIRE(documents.size() == 2);
+    REQUIRE(documents.indexedCount() == 2);
+
+    DocumentInfo second = documents.get(1);
+    REQUIRE(second.path == "coll/b.json");
+    REQUIRE(second.title == "Second");
+    REQUIRE(second.url == "http://b");
+    REQUIRE(second.length == 7);
+    REQUIRE(documents.getLength(1) == 7);
+}
+
+TEST_CASE("a header pointing outside the file is rejected", "[documents]") {
+    TempTable table("documents_header");
+    uint64_t fileSize = fs::file_size(table.name());
+    SECTION("strings past the end") {
+        table.patch(offsetof(DocumentTableHeader, stringsOffset), fileSize + 1);
+    }
+    SECTION("records overlapping the strings") {
+        table.patch(offsetof(DocumentTableHeader, stringsOffset), sizeof(DocumentTableHeader) + sizeof(DocumentRecord));
+    }
+    SECTION("records past the end") {
+        table.patch(offsetof(DocumentTableHeader, recordsOffset), ~uint64_t(0));
+    }
+    DocumentTable documents;
+    REQUIRE_FALSE(documents.loadFromFile(table.name()));
+    REQUIRE(documents.size() == 0);
+}
+
+TEST_CASE("a record pointing outside the strings comes back empty", "[documents]") {
+    TempTable table("documents_record");
+    size_t second = sizeof(DocumentTableHeader) + sizeof(DocumentRecord);
+    table.patch(second + offsetof(DocumentRecord, stringsOffset), ~uint64_t(0) - 4);
+
+    DocumentTable documents;
+    REQUIRE(documents.loadFromFile(table.name()));
+    REQUIRE(documents.get(0).path == "coll/a.json");
+    REQUIRE(documents.get(1).path.empty());
+    REQUIRE(documents.get(1).length == 0);
+    REQUIRE(documents.get(2).path.empty()); // not a document ID of the table
+    REQUIRE(documents.getLength(2) == 0);
+}
@@ -0,0 +1,57 @@
+// english_stem_tests.cpp
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <codecvt>
+#include <fstream>
+#include <locale>
+#include <string>
+#include "document_parser.h"
+#include "english_stem.h"
+#include "fixed_string.h"
+
+// data/stem_golden.txt holds "word stem" lines written by the stemmer before
+// its suffix steps were rewritten (and identical to the original one): root
+// and suffix combinations for every Porter2 step, the exceptional forms, the
+// words of the sample articles and a few UTF-8 and full-width words.
+TEST_CASE("stems match the golden word list", "[stem]") {
+    std::ifstream golden("data/stem_golden.txt");
+    REQUIRE(golden.is_open());
+
+    stemming::english_stem<> stemWide;
+    stemming::english_stem<std::string> stemBytes;
+    stemming::english_stem<FixedString<DocumentParser::maxStackStemLength>> stemStack;
+    std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>> converter;
+
+    size_t count = 0;
+    std::string word;
+    std::string expected;
+    while (golden >> word >> expected) {
+        INFO("word " << word);
+        ++count;
+
+        std::wstring wide = converter.from_bytes(word);
+        stemWide(wide);
+        REQUIRE(converter.to_bytes(wide) == expected);
+
+        bool ascii = std::all_of(word.begin(), word.end(), [](char ch) {
+            return static_cast<unsigned char>(ch) < 0x80;
+        });
+        if (ascii && word.size() <= DocumentParser::maxStackStemLength) {
+            std::string bytes = word;
+            stemBytes(bytes);
+            REQUIRE(bytes == expected);
+
+            FixedString<DocumentParser::maxStackStemLength> text(word);
+            stemStack(text);
+            REQUIRE(text.view() == expected);
+        }
+
+        // Twice: stemmed, then answered from the stem cache
+        for (int pass = 0; pass < 2; ++pass) {
+            std::string out(word.size(), '\0');
+            out.resize(DocumentParser::stemInto(word, &out[0]));
+            REQUIRE(out == expected);
+        }
+    }
+    REQUIRE(count > 6000);
+}
@@ -0,0 +1,171 @@
+// index_builder_tests.cpp
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "index_builder.h"
+#include "index_file.h"
+
+namespace fs = std::filesystem;
+
+// An empty directory in the temporary directory, removed at the end of the test
+class TempDirectory {
+private:
+    fs::path path;
+
+public:
+    explicit TempDirectory(const std::string& name) : path(fs::temp_directory_path() / ("supersearch_test_" + name)) {
+        fs::remove_all(path);
+        fs::create_directory(path);
+    }
+    ~TempDirectory() { fs::remove_all(path); }
+    std::string file(const std::string& name) const { return (path / name).string(); }
+    size_t fileCount() const {
+        return static_cast<size_t>(std::distance(fs::directory_iterator(path), fs::directory_iterator()));
+    }
+};
+
+static std::vector<Posting> readTerm(const std::string& fileName, std::string_view key) {
+    IndexFileReader reader;
+    REQUIRE(reader.open(fileName));
+    TermEntry entry;
+    if (!reader.find(key, entry)) {
+        return {};
+    }
+    std::vector<Posting> postings(entry.postingCount);
+    reader.readPostings(entry, postings.data());
+    return postings;
+}
+
+TEST_CASE("a builder within its budget writes a single run", "[builder]") {
+    TempDirectory directory("builder_single");
+    IndexBuilder builder(directory.file("main"));
+    builder.insertDocument(1, {"market", "fell", "market"});
+    builder.insertDocument(0, {"market", "rallied"}); // out of order, as with work stealing
+    REQUIRE(builder.runCount() == 0);
+
+    std::vector<std::string> runs;
+    REQUIRE(builder.releaseRuns(runs));
+    REQUIRE(runs.size() == 1);
+    REQUIRE(IndexBuilder::mergeRuns(runs, directory.file("index")));
+    REQUIRE_FALSE(fs::exists(runs[0]));
+
+    std::vector<Posting> market = readTerm(directory.file("index"), "market");
+    REQUIRE(market.size() == 2);
+    REQUIRE(market[0].docId == 0);
+    REQUIRE(market[0].frequency == 1);
+    REQUIRE(market[1].docId == 1);
+    REQUIRE(market[1].frequency == 2);
+}
+
+TEST_CASE("runs spilled over the budget merge into one index", "[builder][merge]") {
+    TempDirectory directory("builder_spill");
+    // Two builders, as two index threads, each spilling after every document
+    IndexBuilder even(directory.file("even"), 1);
+    IndexBuilder odd(directory.file("odd"), 1);
+    for (uint32_t document = 0; document < 20; ++document) {
+        std::vector<std::string_view> terms = {"common", "common"};
+        terms.push_back(document % 2 == 0 ? "even" : "odd");
+        if (document % 5 == 0) {
+            terms.push_back("fifth");
+        }
+        (document % 2 == 0 ? even : odd).insertDocument(document, terms);
+    }
+    REQUIRE(even.runCount() == 10);
+    REQUIRE(odd.runCount() == 10);
+
+    std::vector<std::string> runs;
+    REQUIRE(odd.releaseRuns(runs));
+    REQUIRE(even.releaseRuns(runs));
+    REQUIRE(runs.size() == 20);
+    REQUIRE(IndexBuilder::mergeRuns(runs, directory.file("index")));
+    REQUIRE(directory.fileCount() == 1); // the runs are gone
+
+    std::vector<Posting> common = readTerm(directory.file("index"), "common");
+    REQUIRE(common.size() == 20);
+    for (uint32_t document = 0; document < 20; ++document) {
+        REQUIRE(common[document].docId == document);
+        REQUIRE(common[document].frequency == 2);
+    }
+    std::vector<Posting> fifth = readTerm(directory.file("index"), "fifth");
+    REQUIRE(fifth.size() == 4);
+    REQUIRE(fifth[3].docId == 15);
+    REQUIRE(readTerm(directory.file("index"), "odd").size() == 10);
+}
+
+TEST_CASE("a failed run fails the release and removes the other runs", "[builder]") {
+    TempDirectory directory("builder_failed");
+    std::string runs = directory.file("runs");
+    fs::create_directory(runs);
+    IndexBuilder builder((fs::path(runs) / "main").string(), 1);
+
+    builder.insertDocument(0, {"first"});
+    REQUIRE(builder.runCount() == 1);
+
+    // The run directory disappears, e.g. the disk is full or unmounted
+    fs::rename(runs, directory.file("away"));
+    builder.insertDocument(1, {"second"});
+    fs::rename(directory.file("away"), runs);
+    // Nothing more is written once a run failed
+    builder.insertDocument(2, {"third"});
+    REQUIRE(builder.runCount() == 1);
+
+    std::vector<std::string> released;
+    REQUIRE_FALSE(builder.releaseRuns(released));
+    REQUIRE(released.empty());
+    REQUIRE(fs::is_empty(runs));
+    REQUIRE(builder.runCount() == 0);
+}
+
+TEST_CASE("a failed merge keeps the runs", "[builder][merge]") {
+    TempDirectory directory("builder_merge_failed");
+    IndexBuilder builder(directory.file("main"), 1);
+    builder.insertDocument(0, {"first"});
+    builder.insertDocument(1, {"second"});
+
+    std::vector<std::string> runs;
+    REQUIRE(builder.releaseRuns(runs));
+    REQUIRE(runs.size() == 2);
+    std::string unwritable = directory.file("missing/index");
+    REQUIRE_FALSE(IndexBuilder::mergeRuns(runs, unwritable));
+    REQUIRE_FALSE(IndexBuilder::mergeRuns({runs[0]}, unwritable));
+    for (const std::string& run : runs) {
+        REQUIRE(fs::exists(run));
+    }
+
+    REQUIRE(IndexBuilder::mergeRuns(runs, directory.file("index")));
+    REQUIRE(readTerm(directory.file("index"), "second").size() == 1);
+}
+
+TEST_CASE("discard removes what was spilled", "[builder]") {
+    TempDirectory directory("builder_discard");
+    IndexBuilder builder(directory.file("main"), 1);
+    builder.insertDocument(0, {"first"});
+    builder.insertDocument(1, {"second"});
+    REQUIRE(directory.fileCount() == 2);
+
+    builder.discard();
+    REQUIRE(directory.fileCount() == 0);
+    std::vector<std::string> runs;
+    REQUIRE(builder.releaseRuns(runs));
+    REQUIRE(runs.empty());
+}
+
+TEST_CASE("merged and single-run indices keep the build ID", "[builder][merge]") {
+    TempDirectory directory("builder_build_id");
+    for (size_t documents : {1, 3}) {
+        INFO(documents << " runs");
+        IndexBuilder builder(directory.file("main"), 1, 0x1234567890abcdefull);
+        for (uint32_t document = 0; document < documents; ++document) {
+            builder.insertDocument(document, {"term"});
+        }
+        std::vector<std::string> runs;
+        REQUIRE(builder.releaseRuns(runs));
+        REQUIRE(IndexBuilder::mergeRuns(runs, directory.file("index")));
+
+        IndexFileReader reader;
+        REQUIRE(reader.open(directory.file("index")));
+        REQUIRE(reader.buildId() == 0x1234567890abcdefull);
+    }
+}
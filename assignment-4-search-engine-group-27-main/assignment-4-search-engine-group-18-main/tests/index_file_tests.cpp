@@ -0,0 +1,162 @@
+// index_file_tests.cpp
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+#include "index_file.h"
+
+namespace fs = std::filesystem;
+
+// A file name in the temporary directory that is removed again at the end of the test
+class TempFile {
+private:
+    std::string path;
+
+public:
+    explicit TempFile(const std::string& name)
+        : path((fs::temp_directory_path() / ("supersearch_test_" + name)).string()) {
+        fs::remove(path);
+    }
+    ~TempFile() { fs::remove(path); }
+    const std::string& name() const { return path; }
+};
+
+using Terms = std::map<std::string, std::vector<Posting>>;
+
+static uint32_t totalFrequency(const std::vector<Posting>& postings) {
+    uint32_t frequency = 0;
+    for (const Posting& posting : postings) {
+        frequency += posting.frequency;
+    }
+    return frequency;
+}
+
+static bool writeIndex(const std::string& fileName, const Terms& terms) {
+    IndexFileWriter writer;
+    if (!writer.open(fileName)) {
+        return false;
+    }
+    for (const auto& [key, postings] : terms) {
+        writer.addTerm(key, totalFrequency(postings), postings.data(), postings.size());
+    }
+    return writer.close();
+}
+
+static std::vector<Posting> readTerm(const IndexFileReader& reader, const std::string& key) {
+    TermEntry entry;
+    REQUIRE(reader.find(key, entry));
+    std::vector<Posting> postings(entry.postingCount);
+    reader.readPostings(entry, postings.data());
+    return postings;
+}
+
+static void checkPostings(const std::vector<Posting>& actual, const std::vector<Posting>& expected) {
+    REQUIRE(actual.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        INFO("posting " << i);
+        REQUIRE(actual[i].docId == expected[i].docId);
+        REQUIRE(actual[i].frequency == expected[i].frequency);
+    }
+}
+
+TEST_CASE("an index file reads back what was written", "[index]") {
+    TempFile file("roundtrip.idx");
+    Terms terms;
+    terms["apple"] = {{0, 2}, {7, 1}};
+    terms["banana"] = {{3, 4}};
+    for (uint32_t i = 0; i < 300; ++i) {
+        terms["common"].push_back(Posting{3 * i, i % 5 + 1}); // packed blocks plus a tail
+    }
+    terms["zebra"] = {{4000000000u, 1}};
+    REQUIRE(writeIndex(file.name(), terms));
+
+    IndexFileReader reader;
+    REQUIRE(reader.open(file.name()));
+    REQUIRE(reader.termCount() == terms.size());
+
+    size_t i = 0;
+    for (const auto& [key, postings] : terms) {
+        INFO("term " << key);
+        TermEntry entry = reader.entry(i++);
+        REQUIRE(reader.key(entry) == key);
+        REQUIRE(entry.postingCount == postings.size());
+        REQUIRE(entry.frequency == totalFrequency(postings));
+        checkPostings(readTerm(reader, key), postings);
+    }
+
+    TermEntry entry;
+    REQUIRE_FALSE(reader.find("aardvark", entry));
+    REQUIRE_FALSE(reader.find("cherry", entry));
+    REQUIRE_FALSE(reader.find("zzz", entry));
+}
+
+TEST_CASE("an empty index file has no terms", "[index]") {
+    TempFile file("empty.idx");
+    REQUIRE(writeIndex(file.name(), Terms()));
+
+    IndexFileReader reader;
+    REQUIRE(reader.open(file.name()));
+    REQUIRE(reader.termCount() == 0);
+    TermEntry entry;
+    REQUIRE_FALSE(reader.find("anything", entry));
+}
+
+TEST_CASE("files that are not index files are rejected", "[index]") {
+    TempFile file("garbage.idx");
+    IndexFileReader reader;
+    REQUIRE_FALSE(reader.open(file.name()));
+
+    std::ofstream(file.name()) << "this is not an index file, just some text";
+    REQUIRE_FALSE(reader.open(file.name()));
+}
+
+TEST_CASE("merged index files interleave document IDs", "[index][merge]") {
+    TempFile first("merge_first.idx");
+    TempFile second("merge_second.idx");
+    TempFile third("merge_third.idx");
+    TempFile merged("merge_out.idx");
+
+    // Like runs from several parse threads: shared terms, disjoint documents
+    Terms firstTerms, secondTerms, thirdTerms, expected;
+    firstTerms["apple"] = {{0, 1}, {2, 2}, {4, 3}};
+    secondTerms["apple"] = {{1, 5}, {3, 6}};
+    firstTerms["banana"] = {{2, 1}};
+    thirdTerms["cherry"] = {{9, 2}};
+    for (uint32_t docId = 0; docId < 600; ++docId) {
+        Terms& run = docId % 3 == 0 ? firstTerms : docId % 3 == 1 ? secondTerms : thirdTerms;
+        run["common"].push_back(Posting{docId, docId % 7 + 1});
+        expected["common"].push_back(Posting{docId, docId % 7 + 1});
+    }
+    expected["apple"] = {{0, 1}, {1, 5}, {2, 2}, {3, 6}, {4, 3}};
+    expected["banana"] = firstTerms["banana"];
+    expected["cherry"] = thirdTerms["cherry"];
+
+    REQUIRE(writeIndex(first.name(), firstTerms));
+    REQUIRE(writeIndex(second.name(), secondTerms));
+    REQUIRE(writeIndex(third.name(), thirdTerms));
+    REQUIRE(mergeIndexFiles({first.name(), second.name(), third.name()}, merged.name()));
+
+    IndexFileReader reader;
+    REQUIRE(reader.open(merged.name()));
+    REQUIRE(reader.termCount() == expected.size());
+    size_t i = 0;
+    for (const auto& [key, postings] : expected) {
+        INFO("term " << key);
+        TermEntry entry = reader.entry(i++);
+        REQUIRE(reader.key(entry) == key);
+        REQUIRE(entry.frequency == totalFrequency(postings));
+        checkPostings(readTerm(reader, key), postings);
+    }
+}
+
+TEST_CASE("merging fails on a missing input", "[index][merge]") {
+    TempFile input("merge_present.idx");
+    TempFile missing("merge_missing.idx");
+    TempFile merged("merge_failed.idx");
+    REQUIRE(writeIndex(input.name(), Terms{{"apple", {{0, 1}}}}));
+
+    REQUIRE_FALSE(mergeIndexFiles({input.name(), missing.name()}, merged.name()));
+    REQUIRE_FALSE(fs::exists(merged.name()));
+}
@@ -0,0 +1,99 @@
+// json_lines_reader_tests.cpp
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "json_lines_reader.h"
+
+namespace fs = std::filesystem;
+
+// Writes content to a feed in the temporary directory, removed at the end of the test
+class TempFeed {
+private:
+    std::string path;
+
+public:
+    TempFeed(const std::string& name, const std::string& content)
+        : path((fs::temp_directory_path() / ("supersearch_test_" + name)).string()) {
+        std::ofstream(path, std::ios::binary) << content;
+    }
+    ~TempFeed() { fs::remove(path); }
+    const std::string& name() const { return path; }
+};
+
+using Records = std::vector<std::pair<uint64_t, std::string>>;
+
+static Records readAll(const std::string& fileName, size_t bufferSize) {
+    JsonLinesReader feed(bufferSize);
+    REQUIRE(feed.open(fileName));
+    Records records;
+    JsonRecord record;
+    while (feed.next(record)) {
+        records.emplace_back(record.offset, std::string(record.json));
+    }
+    REQUIRE_FALSE(feed.failed());
+    return records;
+}
+
+// Every line is a record at its offset in the feed, whatever the buffer size
+static void checkFeed(const std::string& content, const Records& expected) {
+    TempFeed feed("feed.jsonl", content);
+    for (size_t bufferSize : {1, 2, 7, 16, 64, 4096}) {
+        INFO("buffer size " << bufferSize);
+        Records records = readAll(feed.name(), bufferSize);
+        REQUIRE(records == expected);
+        for (const auto& [offset, json] : records) {
+            REQUIRE(content.compare(offset, json.size(), json) == 0);
+        }
+    }
+}
+
+TEST_CASE("records roll over buffer refills", "[feed]") {
+    std::string content;
+    Records expected;
+    for (int i = 0; i < 50; ++i) {
+        std::string line = "{\"id\": " + std::to_string(i) + "}";
+        expected.emplace_back(content.size(), line);
+        content += line + "\n";
+    }
+    checkFeed(content, expected);
+}
+
+TEST_CASE("a line longer than the buffer grows it", "[feed]") {
+    std::string longLine = "{\"text\": \"" + std::string(1000, 'a') + "\"}";
+    std::string content = "{\"a\": 1}\n" + longLine + "\n{\"b\": 2}\n";
+    checkFeed(content, {{0, "{\"a\": 1}"}, {9, longLine}, {10 + longLine.size(), "{\"b\": 2}"}});
+}
+
+TEST_CASE("the last line may lack its line break", "[feed]") {
+    checkFeed("{\"a\": 1}\n{\"b\": 2}", {{0, "{\"a\": 1}"}, {9, "{\"b\": 2}"}});
+    checkFeed("{\"only\": true}", {{0, "{\"only\": true}"}});
+}
+
+TEST_CASE("blank lines and surrounding whitespace are skipped", "[feed]") {
+    // A CRLF line keeps its carriage return, which the parser stops before
+    std::string content = "\n\n  {\"a\": 1}\r\n\r\n\t\n{\"b\": 2}\n   \n";
+    checkFeed(content, {{4, "{\"a\": 1}\r"}, {18, "{\"b\": 2}"}});
+}
+
+TEST_CASE("an empty feed has no records", "[feed]") {
+    checkFeed("", {});
+    checkFeed(" \n\r\n\n", {});
+}
+
+TEST_CASE("a missing feed cannot be opened", "[feed]") {
+    JsonLinesReader feed(16);
+    REQUIRE_FALSE(feed.open((fs::temp_directory_path() / "supersearch_test_missing.jsonl").string()));
+    JsonRecord record;
+    REQUIRE_FALSE(feed.next(record));
+}
+
+TEST_CASE("JSON Lines feeds are recognized by name", "[feed]") {
+    REQUIRE(JsonLinesReader::isJsonLines("-"));
+    REQUIRE(JsonLinesReader::isJsonLines("crawl/articles.jsonl"));
+    REQUIRE(JsonLinesReader::isJsonLines("articles.ndjson"));
+    REQUIRE_FALSE(JsonLinesReader::isJsonLines("articles.json"));
+    REQUIRE_FALSE(JsonLinesReader::isJsonLines("sample_data"));
+}
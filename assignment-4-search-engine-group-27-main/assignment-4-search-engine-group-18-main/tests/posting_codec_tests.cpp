@@ -0,0 +1,104 @@
+// posting_codec_tests.cpp
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+#include "posting_codec.h"
+
+// Sorted postings whose document gaps and frequencies stay below 2^bits
+static std::vector<Posting> makePostings(size_t count, uint32_t bits, uint32_t seed) {
+    std::mt19937 random(seed);
+    uint32_t limit = bits >= 32 ? ~0u : (1u << bits) - 1;
+    std::uniform_int_distribution<uint32_t> gap(0, limit / 256);
+    std::uniform_int_distribution<uint32_t> frequency(1, limit == 0 ? 1 : limit);
+
+    std::vector<Posting> postings(count);
+    uint32_t docId = 0;
+    for (Posting& posting : postings) {
+        docId += gap(random);
+        posting = Posting{docId, frequency(random)};
+    }
+    return postings;
+}
+
+// Encodes behind a marker byte, decodes, and checks that exactly the encoded
+// bytes were consumed
+static void checkRoundTrip(const std::vector<Posting>& postings) {
+    std::string encoded = "x";
+    encodePostings(postings.data(), postings.size(), encoded);
+    encoded.push_back('y');
+
+    std::vector<Posting> decoded(postings.size() + 1, Posting{12345, 12345});
+    const char* end = decodePostings(encoded.data() + 1, postings.size(), decoded.data());
+    REQUIRE(end == encoded.data() + encoded.size() - 1);
+    for (size_t i = 0; i < postings.size(); ++i) {
+        INFO("posting " << i);
+        REQUIRE(decoded[i].docId == postings[i].docId);
+        REQUIRE(decoded[i].frequency == postings[i].frequency);
+    }
+    // Nothing is written past count
+    REQUIRE(decoded.back().docId == 12345);
+}
+
+TEST_CASE("posting lists round-trip around the block boundaries", "[codec]") {
+    for (size_t count : {0, 1, 3, 4, 5, 127, 128, 129, 131, 255, 256, 257, 1000}) {
+        SECTION("count " + std::to_string(count)) {
+            checkRoundTrip(makePostings(count, 20, static_cast<uint32_t>(count)));
+        }
+    }
+}
+
+TEST_CASE("packed blocks round-trip at every bit width", "[codec]") {
+    for (uint32_t bits = 0; bits <= 32; ++bits) {
+        SECTION("width " + std::to_string(bits)) {
+            std::vector<Posting> postings(2 * postingBlockSize + 3);
+            uint32_t limit = bits == 32 ? ~0u : (1u << bits) - 1;
+            std::mt19937 random(bits);
+            for (size_t i = 0; i < postings.size(); ++i) {
+                // Postings 4 to 7 sit limit past postings 0 to 3, the widest delta
+                // of the first block; the largest frequency comes first
+                uint32_t gap = i == 4 ? limit : i < 8 ? 0 : static_cast<uint32_t>(random()) & (limit >> 8);
+                uint32_t docId = i == 0 ? 0 : postings[i - 1].docId + gap;
+                if (i > 0 && docId < postings[i - 1].docId) {
+                    docId = ~0u;
+                }
+                postings[i] = Posting{docId, bits == 0 ? 0 : limit - static_cast<uint32_t>(i) % limit};
+            }
+            checkRoundTrip(postings);
+        }
+    }
+}
+
+TEST_CASE("varint tails round-trip at the byte boundaries", "[codec]") {
+    std::vector<uint32_t> values = {0, 1, 127, 128, 16383, 16384, 2097151, 2097152, 268435455, 268435456, ~0u};
+    for (size_t prefix : {size_t(0), postingBlockSize}) {
+        SECTION(prefix == 0 ? "short list" : "tail after a block") {
+            std::vector<Posting> postings = makePostings(prefix, 16, 7);
+            uint32_t docId = postings.empty() ? 0 : postings.back().docId;
+            for (uint32_t value : values) {
+                // Gaps of each width, ending on the largest document ID
+                uint32_t gap = value == ~0u ? ~0u - docId : value;
+                docId += gap;
+                postings.push_back(Posting{docId, value});
+            }
+            checkRoundTrip(postings);
+        }
+    }
+}
+
+TEST_CASE("consecutive lists decode back to back", "[codec]") {
+    std::vector<Posting> first = makePostings(300, 16, 1);
+    std::vector<Posting> second = makePostings(5, 16, 2);
+    std::string encoded;
+    encodePostings(first.data(), first.size(), encoded);
+    encodePostings(second.data(), second.size(), encoded);
+
+    std::vector<Posting> decoded(first.size());
+    const char* next = decodePostings(encoded.data(), first.size(), decoded.data());
+    REQUIRE(decoded.back().docId == first.back().docId);
+    decoded.resize(second.size());
+    REQUIRE(decodePostings(next, second.size(), decoded.data()) == encoded.data() + encoded.size());
+    REQUIRE(decoded.front().docId == second.front().docId);
+    REQUIRE(decoded.back().frequency == second.back().frequency);
+}
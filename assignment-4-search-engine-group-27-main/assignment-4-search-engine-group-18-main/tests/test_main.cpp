@@ -0,0 +1,3 @@
+// test_main.cpp
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
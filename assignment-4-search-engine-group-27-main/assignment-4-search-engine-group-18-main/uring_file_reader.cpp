@@ -0,0 +1,322 @@
+// uring_file_reader.cpp
+#include "uring_file_reader.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter) && defined(__NR_io_uring_register)
+#define SUPERSEARCH_HAVE_IO_URING 1
+#endif
+#endif
+
+UringFileReader::UringFileReader(size_t depth)
+    : ringFd(-1), depth(0), submissionRing(nullptr), submissionRingSize(0), completionRing(nullptr),
+      completionRingSize(0), entries(nullptr), entriesSize(0), submissionTail(nullptr), submissionMask(0),
+      submissionArray(nullptr), completionHead(nullptr), completionTail(nullptr), completionMask(0),
+      completions(nullptr), pendingSubmissions(0) {
+    if (!setUp(static_cast<unsigned>(depth == 0 ? 1 : depth))) {
+        tearDown();
+    }
+}
+
+UringFileReader::~UringFileReader() {
+    tearDown();
+}
+
+#ifdef SUPERSEARCH_HAVE_IO_URING
+
+// liburing is not a dependency, so the three system calls are made directly
+static int ringSetup(unsigned entries, io_uring_params* params) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ringEnter(int fd, unsigned submit, unsigned wait, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, submit, wait, flags, nullptr, 0));
+}
+
+static int ringRegister(int fd, unsigned opcode, void* argument, unsigned count) {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, argument, count));
+}
+
+static unsigned* ringField(void* ring, uint32_t offset) {
+    return reinterpret_cast<unsigned*>(static_cast<char*>(ring) + offset);
+}
+
+bool UringFileReader::setUp(unsigned requestedDepth) {
+    io_uring_params params;
+    std::memset(&params, 0, sizeof(params));
+    ringFd = ringSetup(requestedDepth, &params);
+    if (ringFd < 0)
+        return false; // no io_uring in this kernel, or it is disabled
+
+    // Opening and reading through the ring need 5.6 or later
+    std::vector<char> probeMemory(sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op), 0);
+    io_uring_probe* probe = reinterpret_cast<io_uring_probe*>(probeMemory.data());
+    if (ringRegister(ringFd, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+        probe->last_op < IORING_OP_READ ||
+        !(probe->ops[IORING_OP_OPENAT].flags & IO_URING_OP_SUPPORTED) ||
+        !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)) {
+        return false;
+    }
+
+    submissionRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    completionRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMapping) {
+        submissionRingSize = std::max(submissionRingSize, completionRingSize);
+    }
+
+    void* ring = mmap(nullptr, submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ringFd, IORING_OFF_SQ_RING);
+    if (ring == MAP_FAILED)
+        return false;
+    submissionRing = ring;
+
+    if (singleMapping) {
+        completionRing = submissionRing;
+    } else {
+        ring = mmap(nullptr, completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                    ringFd, IORING_OFF_CQ_RING);
+        if (ring == MAP_FAILED)
+            return false;
+        completionRing = ring;
+    }
+
+    entriesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring = mmap(nullptr, entriesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                ringFd, IORING_OFF_SQES);
+    if (ring == MAP_FAILED)
+        return false;
+    entries = ring;
+
+    submissionTail = ringField(submissionRing, params.sq_off.tail);
+    submissionMask = *ringField(submissionRing, params.sq_off.ring_mask);
+    submissionArray = ringField(submissionRing, params.sq_off.array);
+    completionHead = ringField(completionRing, params.cq_off.head);
+    completionTail = ringField(completionRing, params.cq_off.tail);
+    completionMask = *ringField(completionRing, params.cq_off.ring_mask);
+    completions = static_cast<char*>(completionRing) + params.cq_off.cqes;
+
+    // Every slot has at most one operation queued, so the rings never overflow
+    depth = params.sq_entries;
+    slots.resize(depth);
+    return true;
+}
+
+void UringFileReader::tearDown() {
+    for (Slot& slot : slots) {
+        if (slot.fd >= 0) {
+            close(slot.fd);
+            slot.fd = -1;
+        }
+    }
+    if (entries != nullptr) {
+        munmap(entries, entriesSize);
+    }
+    if (completionRing != nullptr && completionRing != submissionRing) {
+        munmap(completionRing, completionRingSize);
+    }
+    if (submissionRing != nullptr) {
+        munmap(submissionRing, submissionRingSize);
+    }
+    if (ringFd >= 0) {
+        close(ringFd);
+    }
+    entries = completionRing = submissionRing = nullptr;
+    ringFd = -1;
+    depth = 0;
+}
+
+// Only this thread writes the submission tail; the kernel reads it
+void UringFileReader::queueOpen(size_t slot, const std::string& path) {
+    unsigned tail = *submissionTail;
+    unsigned index = tail & submissionMask;
+    io_uring_sqe& entry = static_cast<io_uring_sqe*>(entries)[index];
+    std::memset(&entry, 0, sizeof(entry));
+    entry.opcode = IORING_OP_OPENAT;
+    entry.fd = AT_FDCWD;
+    entry.addr = reinterpret_cast<uint64_t>(path.c_str());
+    entry.open_flags = O_RDONLY | O_CLOEXEC;
+    entry.user_data = slot;
+    submissionArray[index] = index;
+    __atomic_store_n(submissionTail, tail + 1, __ATOMIC_RELEASE);
+    ++pendingSubmissions;
+    slots[slot].opening = true;
+}
+
+void UringFileReader::queueRead(size_t slot) {
+    Slot& file = slots[slot];
+    unsigned tail = *submissionTail;
+    unsigned index = tail & submissionMask;
+    io_uring_sqe& entry = static_cast<io_uring_sqe*>(entries)[index];
+    std::memset(&entry, 0, sizeof(entry));
+    entry.opcode = IORING_OP_READ;
+    entry.fd = file.fd;
+    entry.addr = reinterpret_cast<uint64_t>(file.buffer.data() + file.length);
+    entry.len = static_cast<uint32_t>(std::min<size_t>(file.size - file.length, 1u << 30));
+    entry.off = file.length;
+    entry.user_data = slot;
+    submissionArray[index] = index;
+    __atomic_store_n(submissionTail, tail + 1, __ATOMIC_RELEASE);
+    ++pendingSubmissions;
+}
+
+bool UringFileReader::submitAndWait() {
+    while (true) {
+        int result = ringEnter(ringFd, pendingSubmissions, 1, IORING_ENTER_GETEVENTS);
+        if (result >= 0) {
+            pendingSubmissions -= static_cast<unsigned>(result);
+            return true;
+        }
+        if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+            std::cerr << "io_uring_enter failed: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+}
+
+void UringFileReader::abandon() {
+    // Entries the kernel did not take yet are withdrawn, their opens never happen
+    unsigned tail = *submissionTail;
+    for (unsigned queued = tail - pendingSubmissions; queued != tail; ++queued) {
+        const io_uring_sqe& entry = static_cast<const io_uring_sqe*>(entries)[queued & submissionMask];
+        if (entry.opcode == IORING_OP_OPENAT) {
+            slots[static_cast<size_t>(entry.user_data)].opening = false;
+        }
+    }
+    __atomic_store_n(submissionTail, tail - pendingSubmissions, __ATOMIC_RELEASE);
+    pendingSubmissions = 0;
+
+    // An open the kernel finished handed out a descriptor that only its completion names
+    size_t opening = static_cast<size_t>(
+        std::count_if(slots.begin(), slots.end(), [](const Slot& slot) { return slot.opening; }));
+    while (true) {
+        unsigned head = *completionHead;
+        unsigned completed = __atomic_load_n(completionTail, __ATOMIC_ACQUIRE);
+        for (; head != completed; ++head) {
+            const io_uring_cqe& completion = static_cast<const io_uring_cqe*>(completions)[head & completionMask];
+            Slot& file = slots[static_cast<size_t>(completion.user_data)];
+            if (file.opening) {
+                file.opening = false;
+                --opening;
+                if (completion.res >= 0) {
+                    close(completion.res);
+                }
+            }
+        }
+        __atomic_store_n(completionHead, head, __ATOMIC_RELEASE);
+        if (opening == 0 || (ringEnter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)) {
+            break; // at worst the opens still running outlive the ring
+        }
+    }
+    tearDown(); // closes the slots' files
+}
+
+// A slot whose file failed is left closed
+bool UringFileReader::complete(size_t slot, int result, const PathFunction& path) {
+    Slot& file = slots[slot];
+    if (file.fd < 0) {
+        // The open finished
+        file.opening = false;
+        if (result < 0) {
+            std::cerr << "cannot open file: " << path(file.index) << std::endl;
+            return true;
+        }
+        file.fd = result;
+        // The inode is cached after the open, so asking for the size does not block
+        struct stat info;
+        if (fstat(file.fd, &info) != 0) {
+            std::cerr << "cannot read file: " << path(file.index) << std::endl;
+            close(file.fd);
+            file.fd = -1;
+            return true;
+        }
+        file.size = static_cast<size_t>(info.st_size);
+        file.length = 0;
+        file.buffer.resize(file.size + 1);
+    } else if (result < 0) {
+        std::cerr << "cannot read file: " << path(file.index) << std::endl;
+        close(file.fd);
+        file.fd = -1;
+        return true;
+    } else if (result == 0) {
+        file.size = file.length; // the file shrank since fstat
+    } else {
+        file.length += static_cast<size_t>(result);
+    }
+
+    if (file.length < file.size) {
+        queueRead(slot);
+        return false;
+    }
+    return true;
+}
+
+bool UringFileReader::readFiles(size_t count, const PathFunction& path, const FileCallback& done) {
+    if (!isAvailable())
+        return false;
+
+    size_t next = 0;
+    size_t active = 0;
+    for (size_t slot = 0; slot < depth && next < count; ++slot, ++next, ++active) {
+        slots[slot].index = next;
+        queueOpen(slot, path(next));
+    }
+
+    while (active > 0) {
+        if (!submitAndWait()) {
+            abandon();
+            return false;
+        }
+
+        unsigned head = *completionHead;
+        unsigned tail = __atomic_load_n(completionTail, __ATOMIC_ACQUIRE);
+        for (; head != tail; ++head) {
+            const io_uring_cqe& completion = static_cast<const io_uring_cqe*>(completions)[head & completionMask];
+            size_t slot = static_cast<size_t>(completion.user_data);
+            if (!complete(slot, completion.res, path))
+                continue;
+
+            Slot& file = slots[slot];
+            if (file.fd >= 0) {
+                // Closing a file that is already read is quick, it does not go through the ring
+                close(file.fd);
+                file.fd = -1;
+                file.buffer.resize(file.size + 1);
+                file.buffer[file.size] = '\0';
+                done(file.index, file.buffer);
+            }
+
+            if (next < count) {
+                file.index = next;
+                queueOpen(slot, path(next++));
+            } else {
+                --active;
+            }
+        }
+        __atomic_store_n(completionHead, head, __ATOMIC_RELEASE);
+    }
+    return true;
+}
+
+#else
+
+bool UringFileReader::setUp(unsigned) {
+    return false;
+}
+
+void UringFileReader::tearDown() {}
+
+bool UringFileReader::readFiles(size_t, const PathFunction&, const FileCallback&) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,86 @@
+// work_stealing_pool.cpp
+#include "work_stealing_pool.h"
+#include <thread>
+#include <vector>
+
+WorkStealingPool::WorkStealingPool(size_t threadCount)
+    : threadCount(threadCount == 0 ? 1 : threadCount), slices(new Slice[this->threadCount]) {}
+
+size_t WorkStealingPool::defaultThreadCount() {
+    size_t threads = std::thread::hardware_concurrency();
+    return threads == 0 ? 1 : threads;
+}
+
+bool WorkStealingPool::takeOwn(size_t worker, size_t& task) {
+    Slice& slice = slices[worker];
+    std::lock_guard<std::mutex> guard(slice.lock);
+    if (slice.next == slice.end)
+        return false;
+    task = slice.next++;
+    return true;
+}
+
+bool WorkStealingPool::steal(size_t worker) {
+    // Pick the victim with the most work left; the sizes are only a hint
+    size_t victim = worker;
+    size_t largest = 0;
+    for (size_t i = 0; i < threadCount; ++i) {
+        if (i == worker)
+            continue;
+        std::lock_guard<std::mutex> guard(slices[i].lock);
+        size_t remaining = slices[i].end - slices[i].next;
+        if (remaining > largest) {
+            largest = remaining;
+            victim = i;
+        }
+    }
+    if (victim == worker)
+        return false;
+
+    size_t first;
+    size_t last;
+    {
+        std::lock_guard<std::mutex> guard(slices[victim].lock);
+        size_t remaining = slices[victim].end - slices[victim].next;
+        if (remaining == 0)
+            return true; // drained in the meantime, look again
+        // Leave the victim the front half, which it is about to work on
+        last = slices[victim].end;
+        first = last - (remaining + 1) / 2;
+        slices[victim].end = first;
+    }
+
+    std::lock_guard<std::mutex> guard(slices[worker].lock);
+    slices[worker].next = first;
+    slices[worker].end = last;
+    return true;
+}
+
+void WorkStealingPool::work(size_t worker, const std::function<void(size_t, size_t)>& task) {
+    size_t index;
+    while (true) {
+        if (takeOwn(worker, index)) {
+            task(worker, index);
+        } else if (!steal(worker)) {
+            // Tasks are only ever split, never added, so nothing left to steal means done
+            return;
+        }
+    }
+}
+
+void WorkStealingPool::run(size_t count, const std::function<void(size_t, size_t)>& task) {
+    for (size_t i = 0; i < threadCount; ++i) {
+        slices[i].next = count * i / threadCount;
+        slices[i].end = count * (i + 1) / threadCount;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount - 1);
+    for (size_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back([this, i, &task] { work(i, task); });
+    }
+    work(0, task);
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef WORK_STEALING_POOL_H
+#define WORK_STEALING_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+// Runs a batch of independent tasks on a fixed number of threads. Every
+// worker starts on its own contiguous slice of task indices and takes them
+// from the front; a worker that runs dry steals the back half of the
+// largest remaining slice, so slow files on one thread do not leave the
+// others idle.
+class WorkStealingPool {
+private:
+    // One slice per worker, padded so neighbours do not share a cache line
+    struct alignas(64) Slice {
+        std::mutex lock;
+        size_t next = 0;
+        size_t end = 0;
+    };
+
+    size_t threadCount;
+    std::unique_ptr<Slice[]> slices;
+
+    bool takeOwn(size_t worker, size_t& task);
+    bool steal(size_t worker);
+    void work(size_t worker, const std::function<void(size_t, size_t)>& task);
+
+public:
+    explicit WorkStealingPool(size_t threadCount);
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    size_t size() const { return threadCount; }
+    // Calls task(worker, index) for every index in [0, count) and returns once
+    // all of them are done. Worker 0 is the calling thread.
+    void run(size_t count, const std::function<void(size_t, size_t)>& task);
+
+    // hardware_concurrency(), or 1 when it is unknown
+    static size_t defaultThreadCount();
+};
+
+#endif // WORK_STEALING_POOL_H